@@ -0,0 +1,351 @@
+/**********************************************************
+ * Compressed Dictionary Implementation
+ * 压缩词典实现
+ **********************************************************/
+
+#include "compresseddict.h"
+#include <QMap>
+#include <QTextStream>
+#include <climits>
+#include <cstring>
+
+namespace {
+
+// 各级别的裁剪参数
+struct TierLimit {
+    int maxPhraseLength;
+    int maxCandidates;
+};
+
+const TierLimit kTierLimits[] = {
+    {1, 8},                // Tiny
+    {2, 16},               // Compact
+    {4, 32},               // Standard
+    {INT_MAX, INT_MAX},    // Full
+};
+
+} // namespace
+
+CompressedDict::CompressedDict()
+    : m_header(nullptr)
+    , m_blocks(nullptr)
+    , m_keys(nullptr)
+    , m_data(nullptr)
+{
+    m_cache.setMaxCost(DefaultCacheBytes);
+}
+
+bool CompressedDict::open(const QString &path)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qWarning("CompressedDict: cannot open %s", qPrintable(path));
+        return false;
+    }
+
+    const qint64 size = m_file.size();
+    const uchar *data = m_file.map(0, size);
+    if (!isValidImage(data, size)) {
+        qWarning("CompressedDict: invalid dictionary %s", qPrintable(path));
+        m_file.close();
+        return false;
+    }
+
+    const Header *header = reinterpret_cast<const Header *>(data);
+
+    m_header = header;
+    m_blocks = reinterpret_cast<const BlockIndex *>(data + sizeof(Header));
+    m_keys = reinterpret_cast<const uchar *>(m_blocks + header->blockCount);
+    m_data = m_keys + header->keyBytes;
+    return true;
+}
+
+void CompressedDict::close()
+{
+    QMutexLocker locker(&m_mutex);
+    m_cache.clear();
+    m_header = nullptr;
+    m_blocks = nullptr;
+    m_keys = nullptr;
+    m_data = nullptr;
+    m_file.close();
+}
+
+CompressedDict::Tier CompressedDict::tier() const
+{
+    return m_header ? Tier(m_header->tier) : Full;
+}
+
+quint32 CompressedDict::entryCount() const
+{
+    return m_header ? m_header->entryCount : 0;
+}
+
+void CompressedDict::setCacheSize(qsizetype bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_cache.setMaxCost(qMax<qsizetype>(bytes, 0));
+}
+
+CandidateList CompressedDict::lookup(QStringView pinyin) const
+{
+    if (!m_header || pinyin.isEmpty() || pinyin.size() > MaxKeyLength) {
+        return CandidateList();
+    }
+
+    char key[MaxKeyLength];
+    const int length = int(pinyin.size());
+    for (int i = 0; i < length; ++i) {
+        if (pinyin[i].unicode() > 0x7f) {
+            return CandidateList();
+        }
+        key[i] = char(pinyin[i].unicode());
+    }
+
+    const int blockIndex = findBlock(key, length);
+    if (blockIndex < 0) {
+        return CandidateList();
+    }
+
+    // 块内顺序解码：每个键为 [共享前缀长度][后缀长度][后缀]
+    const BlockIndex &index = m_blocks[blockIndex];
+    const uchar *p = m_keys + index.keyOffset;
+    char current[MaxKeyLength];
+    for (quint32 i = 0; i < index.keyCount; ++i) {
+        const int shared = p[0];
+        const int suffix = p[1];
+        std::memcpy(current + shared, p + 2, suffix);
+        p += 2 + suffix;
+
+        const int cmp = compareKeys(current, shared + suffix, key, length);
+        if (cmp > 0) {
+            break;
+        }
+        if (cmp == 0) {
+            const QSharedPointer<const Block> data = block(quint32(blockIndex));
+            if (!data) {
+                return CandidateList();
+            }
+            const QStringView *first = data->candidates.constData();
+            return CandidateList(first + data->starts[i], first + data->starts[i + 1], data);
+        }
+    }
+
+    return CandidateList();
+}
+
+bool CompressedDict::isValidImage(const uchar *data, qint64 size)
+{
+    // 文件来自外部，打开时完整检查一次块索引和键序列，之后的查找不再做边界检查
+    if (!data || size < qint64(sizeof(Header))) {
+        return false;
+    }
+
+    const Header *header = reinterpret_cast<const Header *>(data);
+    if (header->magic != Magic || header->version != Version || header->tier > Full
+        || size < qint64(sizeof(Header)) + qint64(header->blockCount) * qint64(sizeof(BlockIndex))
+                  + header->keyBytes + header->dataBytes) {
+        return false;
+    }
+
+    const BlockIndex *blocks = reinterpret_cast<const BlockIndex *>(data + sizeof(Header));
+    const uchar *keys = reinterpret_cast<const uchar *>(blocks + header->blockCount);
+
+    // 每块 1 到 BlockSize 个键，压缩数据落在数据区内；
+    // 键记录不越界、长度不超过 MaxKeyLength、块首键完整存储，且全部键严格递增
+    char previous[MaxKeyLength];
+    char current[MaxKeyLength];
+    int previousLength = -1;
+    quint64 entryCount = 0;
+    for (quint32 b = 0; b < header->blockCount; ++b) {
+        const BlockIndex &block = blocks[b];
+        if (block.keyCount == 0 || block.keyCount > quint32(BlockSize)
+            || quint64(block.dataOffset) + block.dataSize > header->dataBytes
+            || block.keyOffset >= header->keyBytes) {
+            return false;
+        }
+
+        quint64 offset = block.keyOffset;
+        for (quint32 i = 0; i < block.keyCount; ++i) {
+            if (offset + 2 > header->keyBytes) {
+                return false;
+            }
+            const int shared = keys[offset];
+            const int suffix = keys[offset + 1];
+            if ((i == 0 && shared != 0) || (i > 0 && shared > previousLength)
+                || shared + suffix > MaxKeyLength || offset + 2 + suffix > header->keyBytes) {
+                return false;
+            }
+
+            std::memcpy(current + shared, keys + offset + 2, size_t(suffix));
+            const int length = shared + suffix;
+            if (previousLength >= 0 && compareKeys(previous, previousLength, current, length) >= 0) {
+                return false;
+            }
+            std::memcpy(previous, current, size_t(length));
+            previousLength = length;
+            offset += 2 + quint64(suffix);
+        }
+        entryCount += block.keyCount;
+    }
+
+    return entryCount == header->entryCount;
+}
+
+int CompressedDict::compareKeys(const char *a, int aLength, const char *b, int bLength)
+{
+    const int cmp = std::memcmp(a, b, size_t(qMin(aLength, bLength)));
+    return cmp != 0 ? cmp : aLength - bLength;
+}
+
+int CompressedDict::findBlock(const char *key, int length) const
+{
+    // 每块首键完整存储，二分查找最后一个首键不大于 key 的块
+    quint32 lo = 0;
+    quint32 hi = m_header->blockCount;
+    while (lo < hi) {
+        const quint32 mid = (lo + hi) / 2;
+        const uchar *first = m_keys + m_blocks[mid].keyOffset;
+        if (compareKeys(reinterpret_cast<const char *>(first + 2), first[1], key, length) <= 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return int(lo) - 1;
+}
+
+QSharedPointer<const CompressedDict::Block> CompressedDict::block(quint32 index) const
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (const QSharedPointer<const Block> *cached = m_cache.object(index)) {
+            return *cached;
+        }
+    }
+
+    const BlockIndex &entry = m_blocks[index];
+    const QByteArray raw = qUncompress(m_data + entry.dataOffset, qsizetype(entry.dataSize));
+    if (raw.isEmpty()) {
+        qWarning("CompressedDict: corrupt block %u", index);
+        return QSharedPointer<const Block>();
+    }
+
+    // 候选数据为 UTF-16 文本：条目以换行分隔，候选以空格分隔
+    QSharedPointer<Block> block(new Block);
+    block->text = QString(reinterpret_cast<const QChar *>(raw.constData()), raw.size() / 2);
+
+    const QStringView text(block->text);
+    qsizetype start = 0;
+    quint32 entryIndex = 0;
+    for (qsizetype i = 0; i <= text.size() && entryIndex < entry.keyCount; ++i) {
+        if (i == text.size() || text[i] == u'\n') {
+            block->starts[entryIndex++] = block->candidates.size();
+            splitCandidates(text.sliced(start, i - start), &block->candidates);
+            start = i + 1;
+        }
+    }
+    while (entryIndex <= entry.keyCount) {
+        block->starts[entryIndex++] = block->candidates.size();
+    }
+
+    const qsizetype cost = block->text.size() * qsizetype(sizeof(QChar))
+            + block->candidates.size() * qsizetype(sizeof(QStringView)) + qsizetype(sizeof(Block));
+
+    // 超过缓存上限的块不入缓存，只由返回的列表持有
+    // 其他线程可能同时解压了同一块，后插入的替换先插入的，已返回的列表不受影响
+    QMutexLocker locker(&m_mutex);
+    if (cost <= m_cache.maxCost()) {
+        m_cache.insert(index, new QSharedPointer<const Block>(block), cost);
+    }
+    return block;
+}
+
+bool CompressedDict::build(const QString &sourcePath, const QString &outputPath, Tier tier)
+{
+    QFile source(sourcePath);
+    if (!source.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qWarning("CompressedDict: cannot open %s", qPrintable(sourcePath));
+        return false;
+    }
+
+    // 读取并按级别裁剪，相同拼音的候选合并（按键排序）
+    const TierLimit &limit = kTierLimits[tier];
+    QMap<QByteArray, QStringList> entries;
+    QTextStream stream(&source);
+    while (!stream.atEnd()) {
+        const QStringList fields = stream.readLine().split(u' ', Qt::SkipEmptyParts);
+        if (fields.size() < 2 || fields.first().startsWith(u'#')) {
+            continue;
+        }
+
+        const QByteArray key = fields.first().toLower().toLatin1();
+        if (key.size() > MaxKeyLength) {
+            continue;
+        }
+
+        QStringList &candidates = entries[key];
+        for (qsizetype i = 1; i < fields.size() && candidates.size() < limit.maxCandidates; ++i) {
+            if (fields.at(i).size() <= limit.maxPhraseLength && !candidates.contains(fields.at(i))) {
+                candidates.append(fields.at(i));
+            }
+        }
+        if (candidates.isEmpty()) {
+            entries.remove(key);
+        }
+    }
+
+    QByteArray index;
+    QByteArray keys;
+    QByteArray data;
+    quint32 blockCount = 0;
+
+    auto it = entries.constBegin();
+    while (it != entries.constEnd()) {
+        BlockIndex block{quint32(keys.size()), quint32(data.size()), 0, 0};
+        QString text;
+        QByteArray previous;
+
+        // 前缀编码：每块第一个键完整存储，其余只存与前一个键不同的后缀
+        for (; it != entries.constEnd() && block.keyCount < BlockSize; ++it) {
+            const QByteArray &key = it.key();
+            int shared = 0;
+            while (shared < previous.size() && shared < key.size() && previous[shared] == key[shared]) {
+                ++shared;
+            }
+            keys.append(char(shared));
+            keys.append(char(key.size() - shared));
+            keys.append(key.constData() + shared, key.size() - shared);
+            previous = key;
+
+            if (block.keyCount > 0) {
+                text += u'\n';
+            }
+            text += it.value().join(u' ');
+            ++block.keyCount;
+        }
+
+        const QByteArray compressed = qCompress(reinterpret_cast<const uchar *>(text.constData()),
+                                                text.size() * qsizetype(sizeof(QChar)), 9);
+        block.dataSize = quint32(compressed.size());
+        data.append(compressed);
+        index.append(reinterpret_cast<const char *>(&block), sizeof(block));
+        ++blockCount;
+    }
+
+    const Header header{Magic, Version, quint32(tier), quint32(entries.size()), blockCount,
+                        quint32(keys.size()), quint32(data.size()), 0};
+
+    QFile output(outputPath);
+    if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning("CompressedDict: cannot write %s", qPrintable(outputPath));
+        return false;
+    }
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    output.write(index);
+    output.write(keys);
+    output.write(data);
+    return output.error() == QFile::NoError;
+}
@@ -0,0 +1,106 @@
+/**********************************************************
+ * Compressed Dictionary - tiered, block-compressed storage
+ * 压缩词典（分级、按块压缩，按需解压）
+ **********************************************************/
+
+#ifndef COMPRESSEDDICT_H
+#define COMPRESSEDDICT_H
+
+#include <QCache>
+#include <QFile>
+#include <QList>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringView>
+
+#include "pinyindict.h"
+
+// 压缩拼音词典
+// 文件布局：头部 + 块索引 + 前缀编码的拼音键 + 按块压缩的候选词。
+// 文件直接映射使用，常驻内存只有块索引；查找时二分定位块、顺序解码块内键，
+// 只解压命中的候选块并放入按字节计费的 LRU 缓存，内存上限可配置。
+// 文件按本机字节序存储，由 build() 在同类平台上生成。
+// 查找可在多个线程中同时进行，缓存由互斥锁保护，解压在锁外进行。
+class CompressedDict
+{
+public:
+    // 词典规模分级：生成词典时按级别裁剪词组长度与每个拼音的候选数
+    enum Tier {
+        Tiny,       // 仅单字，每个拼音最多 8 个候选
+        Compact,    // 两字以内，最多 16 个
+        Standard,   // 四字以内，最多 32 个
+        Full        // 不裁剪
+    };
+
+    static constexpr int BlockSize = 32;        // 每块的键数
+    static constexpr int MaxKeyLength = 64;
+    static constexpr qsizetype DefaultCacheBytes = 256 * 1024;
+
+    CompressedDict();
+
+    bool open(const QString &path);
+    void close();
+    bool isOpen() const { return m_header != nullptr; }
+
+    Tier tier() const;
+    quint32 entryCount() const;
+
+    // 解压缓存上限（字节）
+    void setCacheSize(qsizetype bytes);
+    qsizetype cacheSize() const { return m_cache.maxCost(); }
+
+    // 查找拼音对应的候选词，返回的列表持有其所在的解压块
+    CandidateList lookup(QStringView pinyin) const;
+
+    // 由文本词典（每行 "拼音 候选1 候选2 ..."，候选按词频排列）生成指定级别的压缩词典
+    static bool build(const QString &sourcePath, const QString &outputPath, Tier tier);
+
+private:
+    Q_DISABLE_COPY(CompressedDict)
+
+    static constexpr quint32 Magic = 0x43445950u;   // "PYDC"
+    static constexpr quint32 Version = 1;
+
+    struct Header {
+        quint32 magic;
+        quint32 version;
+        quint32 tier;
+        quint32 entryCount;
+        quint32 blockCount;
+        quint32 keyBytes;
+        quint32 dataBytes;
+        quint32 reserved;
+    };
+
+    struct BlockIndex {
+        quint32 keyOffset;    // 块内第一个键（完整存储）的位置
+        quint32 dataOffset;   // 压缩候选数据的位置
+        quint32 dataSize;
+        quint32 keyCount;
+    };
+
+    // 解压后的块：候选文本及每个条目在 candidates 中的起点
+    struct Block {
+        QString text;
+        QList<QStringView> candidates;
+        qsizetype starts[BlockSize + 1];
+    };
+
+    static bool isValidImage(const uchar *data, qint64 size);
+    static int compareKeys(const char *a, int aLength, const char *b, int bLength);
+    int findBlock(const char *key, int length) const;
+    QSharedPointer<const Block> block(quint32 index) const;
+
+    QFile m_file;
+    const Header *m_header;
+    const BlockIndex *m_blocks;
+    const uchar *m_keys;
+    const uchar *m_data;
+
+    // 成本按字节计；被淘汰的块在仍被候选列表引用时继续存活
+    mutable QCache<quint32, QSharedPointer<const Block>> m_cache;
+    mutable QMutex m_mutex;
+};
+
+#endif // COMPRESSEDDICT_H
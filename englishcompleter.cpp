@@ -0,0 +1,183 @@
+/**********************************************************
+ * English Completer Implementation
+ * 英文单词补全实现
+ **********************************************************/
+
+#include "englishcompleter.h"
+#include "englishlexicon.h"
+#include <algorithm>
+
+namespace {
+
+// 一次补全的结果：单词及指向它们的视图，由返回的候选列表共同持有
+struct Completions {
+    QList<QString> words;
+    QList<QStringView> views;
+};
+
+} // namespace
+
+EnglishCompleter::EnglishCompleter()
+    : m_revision(0)
+{
+    reset();
+}
+
+bool EnglishCompleter::feed(QChar key)
+{
+    return feedTouch(key, KeyGuess::exact(key));
+}
+
+bool EnglishCompleter::feedTouch(QChar key, const KeyGuess &guess)
+{
+    const QChar lower = key.toLower();
+    if (lower < u'a' || lower > u'z') {
+        return false;
+    }
+
+    // 概率中不含实际按键时按确定输入处理
+    bool hasKey = false;
+    for (int i = 0; i < guess.count; ++i) {
+        hasKey = hasKey || guess.letters[i] == lower.unicode();
+    }
+
+    sync();
+    m_prefix.append(key);
+    m_states.append(EnglishDawg::instance().advance(m_states.last(), lower));
+    m_guesses.append(hasKey ? guess : KeyGuess::exact(lower));
+    update();
+    return true;
+}
+
+bool EnglishCompleter::backspace()
+{
+    if (m_prefix.isEmpty()) {
+        return false;
+    }
+
+    sync();
+    m_prefix.chop(1);
+    m_states.removeLast();
+    m_guesses.removeLast();
+    update();
+    return true;
+}
+
+void EnglishCompleter::reset()
+{
+    m_prefix.clear();
+    m_states.clear();
+    m_states.append(EnglishDawg::instance().root());
+    m_guesses.clear();
+    m_revision = EnglishLexicon::instance().revision();
+    m_completions = CandidateList();
+}
+
+void EnglishCompleter::sync()
+{
+    // 词库重新加载后词图已重建，旧状态失效，按已输入的字母重新下降
+    const quint32 revision = EnglishLexicon::instance().revision();
+    if (revision == m_revision) {
+        return;
+    }
+
+    const EnglishDawg &dawg = EnglishDawg::instance();
+    m_revision = revision;
+    m_states.resize(1);
+    m_states[0] = dawg.root();
+    for (QChar letter : std::as_const(m_prefix)) {
+        m_states.append(dawg.advance(m_states.last(), letter.toLower()));
+    }
+}
+
+void EnglishCompleter::update()
+{
+    m_completions = CandidateList();
+    if (m_prefix.isEmpty()) {
+        return;
+    }
+
+    // 按原样不是任何单词的前缀时，按触点概率尝试相邻按键
+    const EnglishDawg &dawg = EnglishDawg::instance();
+    EnglishDawg::State state = m_states.last();
+    const bool corrected = !state.isValid();
+    if (corrected) {
+        state = fuzzyState();
+    }
+
+    // 前缀本身是单词时位于区间首位，多取一个以便剔除；纠正后的单词本身保留
+    const bool skipPrefix = state.final && !corrected;
+    const QList<quint32> ranks = dawg.topRanks(state, MaxCompletions + (skipPrefix ? 1 : 0));
+
+    QSharedPointer<Completions> result(new Completions);
+    result->words.reserve(ranks.size());
+    for (quint32 rank : ranks) {
+        if ((skipPrefix && rank == state.first) || result->words.size() == MaxCompletions) {
+            continue;
+        }
+        result->words.append(dawg.wordAt(rank));
+    }
+    if (result->words.isEmpty()) {
+        return;
+    }
+
+    // 单词全部加入后再取视图，列表扩容不会移动字符串数据
+    result->views.reserve(result->words.size());
+    for (const QString &word : std::as_const(result->words)) {
+        result->views.append(word);
+    }
+
+    const QStringView *first = result->views.constData();
+    m_completions = CandidateList(first, first + result->views.size(), result);
+}
+
+namespace {
+
+struct Beam {
+    EnglishDawg::State state;
+    float score;
+};
+
+} // namespace
+
+EnglishDawg::State EnglishCompleter::fuzzyState() const
+{
+    const int length = int(m_guesses.size());
+    if (length == 0 || length > MaxFuzzyLength) {
+        return EnglishDawg::State();
+    }
+
+    // 集束搜索：每步只保留得分最高且仍是某个单词前缀的 BeamWidth 条路径
+    const EnglishDawg &dawg = EnglishDawg::instance();
+    Beam beams[BeamWidth];
+    Beam expanded[BeamWidth * KeyGuess::MaxLetters];
+    int beamCount = 1;
+    beams[0] = Beam{dawg.root(), 1.0f};
+
+    for (int pos = 0; pos < length; ++pos) {
+        const KeyGuess &guess = m_guesses.at(pos);
+        int expandedCount = 0;
+
+        for (int b = 0; b < beamCount; ++b) {
+            for (int i = 0; i < guess.count; ++i) {
+                const EnglishDawg::State state = dawg.advance(beams[b].state, QChar(guess.letters[i]));
+                if (state.isValid()) {
+                    expanded[expandedCount++] = Beam{state, beams[b].score * guess.probabilities[i]};
+                }
+            }
+        }
+
+        std::sort(expanded, expanded + expandedCount, [](const Beam &a, const Beam &b) {
+            return a.score > b.score;
+        });
+
+        beamCount = qMin(expandedCount, int(BeamWidth));
+        if (beamCount == 0) {
+            return EnglishDawg::State();
+        }
+        std::copy(expanded, expanded + beamCount, beams);
+    }
+
+    // 剩下的路径都是某些单词的前缀，取得分最高的一条
+    return beams[0].state;
+}
@@ -0,0 +1,60 @@
+/**********************************************************
+ * English Completer - prefix completion over the DAWG
+ * 英文单词补全（逐键在词图中下降）
+ **********************************************************/
+
+#ifndef ENGLISHCOMPLETER_H
+#define ENGLISHCOMPLETER_H
+
+#include <QString>
+#include <QList>
+
+#include "englishdawg.h"
+#include "keyspatialmodel.h"
+#include "pinyindict.h"
+
+// 英文补全 - 跟踪当前正在输入的单词，每个字母只在词图中下降一步
+// 英文字母仍直接发送到目标控件，这里只负责给出补全
+class EnglishCompleter
+{
+public:
+    static constexpr int MaxCompletions = 8;
+
+    // 纠错搜索的参数：超过该长度的输入不再纠错
+    static constexpr int MaxFuzzyLength = 24;
+    static constexpr int BeamWidth = 8;
+
+    EnglishCompleter();
+
+    // 输入一个键：字母返回 true，其他键应由调用方 reset()
+    bool feed(QChar key);
+
+    // 带触点概率的字母：按原样没有补全时，按相邻按键纠正前缀
+    // 纠正后的补全不以已输入的前缀开头（含纠正后的单词本身）
+    bool feedTouch(QChar key, const KeyGuess &guess);
+
+    // 删除最后一个字母（恢复上一步的状态，不重新查找），没有字母时返回 false
+    bool backspace();
+
+    void reset();
+
+    bool isComposing() const { return !m_prefix.isEmpty(); }
+    const QString &prefix() const { return m_prefix; }
+
+    // 当前前缀的补全（不含前缀本身），按词频降序
+    // 返回的列表持有补全结果，之后的输入或重置不影响已返回的列表
+    CandidateList completions() const { return m_completions; }
+
+private:
+    void update();
+    void sync();
+    EnglishDawg::State fuzzyState() const;
+
+    QString m_prefix;                       // 已输入的字母（保留大小写）
+    QList<EnglishDawg::State> m_states;     // 第 i 项为输入 i 个字母后的状态
+    QList<KeyGuess> m_guesses;              // 每个字母的触点概率
+    quint32 m_revision;                     // m_states 对应的词库版本
+    CandidateList m_completions;
+};
+
+#endif // ENGLISHCOMPLETER_H
@@ -0,0 +1,474 @@
+/**********************************************************
+ * English DAWG Implementation
+ * 英文最小化词图实现
+ **********************************************************/
+
+#include "englishdawg.h"
+#include "englishlexicon.h"
+#include <QHash>
+#include <algorithm>
+
+EnglishDawg &EnglishDawg::instance()
+{
+    static EnglishDawg dawg;
+    return dawg;
+}
+
+EnglishDawg::EnglishDawg()
+    : m_header(nullptr)
+    , m_edges(nullptr)
+    , m_frequencies(nullptr)
+    , m_tree(nullptr)
+{
+    build(EnglishLexicon::instance());
+}
+
+void EnglishDawg::build(const EnglishLexicon &lexicon)
+{
+    // 单词按字典序排序去重，重复的词保留较高的词频
+    QList<qsizetype> order;
+    order.reserve(lexicon.size());
+    for (qsizetype i = 0; i < lexicon.size(); ++i) {
+        order.append(i);
+    }
+    std::sort(order.begin(), order.end(), [&lexicon](qsizetype a, qsizetype b) {
+        const int cmp = lexicon.word(a).compare(lexicon.word(b));
+        return cmp != 0 ? cmp < 0 : lexicon.frequency(a) > lexicon.frequency(b);
+    });
+
+    QList<QStringView> words;
+    QList<quint32> frequencies;
+    words.reserve(order.size());
+    frequencies.reserve(order.size());
+    for (qsizetype index : std::as_const(order)) {
+        const QStringView word = lexicon.word(index);
+        if (!words.isEmpty() && words.last() == word) {
+            continue;
+        }
+        words.append(word);
+        frequencies.append(lexicon.frequency(index));
+    }
+
+    // 增量构建最小化词图（Daciuk 算法）：输入有序时，
+    // 与上一个词不共享的后缀结点可以立即与已登记的等价结点合并
+    struct Node {
+        bool final = false;
+        QList<QPair<char16_t, int>> edges;
+    };
+    struct Unchecked {
+        int parent;
+        int child;
+    };
+
+    QList<Node> nodes(1);
+    QList<Unchecked> unchecked;
+    QHash<QString, int> registry;
+
+    auto signature = [&nodes](int id) {
+        const Node &node = nodes.at(id);
+        QString key(1 + node.edges.size() * 3, Qt::Uninitialized);
+        QChar *out = key.data();
+        *out++ = QChar(node.final ? u'1' : u'0');
+        for (const auto &edge : node.edges) {
+            *out++ = QChar(edge.first);
+            *out++ = QChar(char16_t(edge.second & 0xffff));
+            *out++ = QChar(char16_t(edge.second >> 16));
+        }
+        return key;
+    };
+
+    auto minimize = [&](qsizetype downTo) {
+        while (unchecked.size() > downTo) {
+            const Unchecked item = unchecked.takeLast();
+            const QString key = signature(item.child);
+            const auto it = registry.constFind(key);
+            if (it != registry.constEnd()) {
+                nodes[item.parent].edges.last().second = it.value();
+            } else {
+                registry.insert(key, item.child);
+            }
+        }
+    };
+
+    QStringView previous;
+    for (QStringView word : std::as_const(words)) {
+        qsizetype common = 0;
+        while (common < word.size() && common < previous.size() && word[common] == previous[common]) {
+            ++common;
+        }
+        minimize(common);
+
+        int node = unchecked.isEmpty() ? 0 : unchecked.last().child;
+        for (qsizetype i = common; i < word.size(); ++i) {
+            const int child = int(nodes.size());
+            nodes.append(Node());
+            nodes[node].edges.append(qMakePair(word[i].unicode(), child));
+            unchecked.append(Unchecked{node, child});
+            node = child;
+        }
+        nodes[node].final = true;
+        previous = word;
+    }
+    minimize(0);
+
+    // 后序遍历可达结点，统计每个结点下的单词数（共享的后缀结点只计算一次）
+    QList<quint32> counts(nodes.size(), NoEdge);
+    QList<int> postOrder;
+    QList<QPair<int, qsizetype>> stack{qMakePair(0, qsizetype(0))};
+    quint32 edgeCount = 0;
+    while (!stack.isEmpty()) {
+        const int id = stack.last().first;
+        const auto &edges = nodes.at(id).edges;
+        if (stack.last().second < edges.size()) {
+            const int child = edges.at(stack.last().second++).second;
+            if (counts.at(child) == NoEdge) {
+                counts[child] = 0;   // 暂作已访问标记
+                stack.append(qMakePair(child, qsizetype(0)));
+            }
+            continue;
+        }
+
+        quint32 count = nodes.at(id).final ? 1 : 0;
+        for (const auto &edge : edges) {
+            count += counts.at(edge.second);
+        }
+        counts[id] = count;
+        edgeCount += quint32(edges.size());
+        postOrder.append(id);
+        stack.removeLast();
+    }
+
+    // 逆后序排列结点的出边，根结点在最前
+    QList<quint32> offsets(nodes.size(), NoEdge);
+    QList<int> reachable(postOrder.crbegin(), postOrder.crend());
+    quint32 next = 0;
+    for (int id : std::as_const(reachable)) {
+        const qsizetype size = nodes.at(id).edges.size();
+        offsets[id] = size ? next : NoEdge;
+        next += quint32(size);
+    }
+
+    // 线段树：叶子为各排名，内部结点保存区间内词频最高的排名
+    const quint32 wordCount = quint32(words.size());
+    quint32 leaves = 1;
+    while (leaves < wordCount) {
+        leaves <<= 1;
+    }
+
+    const Header header{Magic, Version, edgeCount, wordCount, offsets.at(0), leaves};
+    QByteArray image(imageSize(header), Qt::Uninitialized);
+    uchar *data = reinterpret_cast<uchar *>(image.data());
+    *reinterpret_cast<Header *>(data) = header;
+
+    Edge *edges = reinterpret_cast<Edge *>(data + sizeof(Header));
+    for (int id : std::as_const(reachable)) {
+        const auto &list = nodes.at(id).edges;
+        for (qsizetype i = 0; i < list.size(); ++i) {
+            const int child = list.at(i).second;
+            quint16 flags = nodes.at(child).final ? FinalEdge : 0;
+            if (i == list.size() - 1) {
+                flags |= LastEdge;
+            }
+            edges[offsets.at(id) + i] = Edge{offsets.at(child), counts.at(child), list.at(i).first, flags};
+        }
+    }
+
+    quint32 *freqs = reinterpret_cast<quint32 *>(edges + edgeCount);
+    std::copy(frequencies.cbegin(), frequencies.cend(), freqs);
+
+    quint32 *tree = freqs + wordCount;
+    for (quint32 i = 0; i < leaves; ++i) {
+        tree[leaves + i] = i < wordCount ? i : NoEdge;
+    }
+    for (quint32 i = leaves - 1; i > 0; --i) {
+        const quint32 a = tree[2 * i];
+        const quint32 b = tree[2 * i + 1];
+        tree[i] = (b != NoEdge && (a == NoEdge || freqs[b] > freqs[a])) ? b : a;
+    }
+    tree[0] = NoEdge;
+
+    m_file.close();
+    m_image = image;
+    attach(reinterpret_cast<const uchar *>(m_image.constData()), m_image.size());
+}
+
+bool EnglishDawg::saveToFile(const QString &path) const
+{
+    if (!m_header) {
+        return false;
+    }
+
+    const qint64 size = imageSize(*m_header);
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning("EnglishDawg: cannot write %s", qPrintable(path));
+        return false;
+    }
+    return file.write(reinterpret_cast<const char *>(m_header), size) == size;
+}
+
+bool EnglishDawg::loadFromFile(const QString &path)
+{
+    // 先完整检查文件内容，损坏或截断时保留当前（内存中构建的）词图
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            qWarning("EnglishDawg: cannot open %s", qPrintable(path));
+            return false;
+        }
+        if (!isValidImage(file.map(0, file.size()), file.size())) {
+            qWarning("EnglishDawg: invalid dictionary %s", qPrintable(path));
+            return false;
+        }
+    }
+
+    // 映射成功后释放内存中构建的词图
+    m_file.close();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly) || !attach(m_file.map(0, m_file.size()), m_file.size())) {
+        qWarning("EnglishDawg: cannot map %s", qPrintable(path));
+        build(EnglishLexicon::instance());
+        return false;
+    }
+    m_image.clear();
+    return true;
+}
+
+bool EnglishDawg::isValidHeader(const uchar *data, qint64 size)
+{
+    if (!data || size < qint64(sizeof(Header))) {
+        return false;
+    }
+
+    const Header *header = reinterpret_cast<const Header *>(data);
+    return header->magic == Magic && header->version == Version
+        && header->treeLeaves >= header->wordCount
+        && size >= imageSize(*header);
+}
+
+bool EnglishDawg::isValidImage(const uchar *data, qint64 size)
+{
+    // 文件来自外部，加载时完整检查一次，之后的查找不再做边界检查
+    if (!isValidHeader(data, size)) {
+        return false;
+    }
+
+    const Header *header = reinterpret_cast<const Header *>(data);
+    const Edge *edges = reinterpret_cast<const Edge *>(data + sizeof(Header));
+    const quint32 edgeCount = header->edgeCount;
+    if (edgeCount == 0) {
+        return header->wordCount == 0 && header->rootEdge == NoEdge;
+    }
+
+    // 出边按结点分段存放，每段以 LastEdge 结束；记录每段起点及段内单词数之和
+    QList<quint64> runSums(edgeCount, 0);
+    QList<bool> runStarts(edgeCount, false);
+    for (quint32 start = 0, i = 0; i < edgeCount; ++i) {
+        runSums[start] += edges[i].count;
+        if (edges[i].flags & LastEdge) {
+            runStarts[start] = true;
+            start = i + 1;
+        } else if (i == edgeCount - 1) {
+            return false;
+        }
+    }
+
+    // 目标结点必须排在边之后（保证无环、下降必然终止），且单词数与目标结点一致，
+    // 这样所有排名都落在 [0, wordCount) 内
+    for (quint32 i = 0; i < edgeCount; ++i) {
+        const Edge &edge = edges[i];
+        quint64 expected = (edge.flags & FinalEdge) ? 1 : 0;
+        if (edge.target != NoEdge) {
+            if (edge.target <= i || edge.target >= edgeCount || !runStarts.at(edge.target)) {
+                return false;
+            }
+            expected += runSums.at(edge.target);
+        }
+        if (edge.count != expected || expected == 0) {
+            return false;
+        }
+    }
+
+    if (header->rootEdge >= edgeCount || !runStarts.at(header->rootEdge)
+        || runSums.at(header->rootEdge) != header->wordCount) {
+        return false;
+    }
+
+    // 线段树只能引用有效排名
+    const quint32 *tree = reinterpret_cast<const quint32 *>(edges + edgeCount) + header->wordCount;
+    for (quint64 i = 1; i < quint64(header->treeLeaves) * 2; ++i) {
+        if (tree[i] != NoEdge && tree[i] >= header->wordCount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+qint64 EnglishDawg::imageSize(const Header &header)
+{
+    return qint64(sizeof(Header)) + qint64(header.edgeCount) * qint64(sizeof(Edge))
+        + qint64(header.wordCount) * 4 + qint64(header.treeLeaves) * 2 * 4;
+}
+
+bool EnglishDawg::attach(const uchar *data, qint64 size)
+{
+    m_header = nullptr;
+    m_edges = nullptr;
+    m_frequencies = nullptr;
+    m_tree = nullptr;
+
+    // 内存中构建的词图与已检查过的文件只需检查头部
+    if (!isValidHeader(data, size)) {
+        return false;
+    }
+
+    m_header = reinterpret_cast<const Header *>(data);
+    m_edges = reinterpret_cast<const Edge *>(data + sizeof(Header));
+    m_frequencies = reinterpret_cast<const quint32 *>(m_edges + m_header->edgeCount);
+    m_tree = m_frequencies + m_header->wordCount;
+    return true;
+}
+
+EnglishDawg::State EnglishDawg::root() const
+{
+    State state;
+    if (m_header && m_header->wordCount > 0) {
+        state.edge = m_header->rootEdge;
+        state.count = m_header->wordCount;
+    }
+    return state;
+}
+
+EnglishDawg::State EnglishDawg::advance(const State &state, QChar letter) const
+{
+    if (!state.isValid() || state.edge == NoEdge) {
+        return State();
+    }
+
+    // 出边按字母升序：累加跳过的单词数得到新区间的起点
+    quint32 first = state.first + (state.final ? 1 : 0);
+    for (quint32 i = state.edge; ; ++i) {
+        const Edge &edge = m_edges[i];
+        if (edge.letter == letter.unicode()) {
+            State next;
+            next.edge = edge.target;
+            next.first = first;
+            next.count = edge.count;
+            next.final = edge.flags & FinalEdge;
+            return next;
+        }
+        if (edge.letter > letter.unicode() || (edge.flags & LastEdge)) {
+            return State();
+        }
+        first += edge.count;
+    }
+}
+
+QList<quint32> EnglishDawg::topRanks(const State &state, int k) const
+{
+    QList<quint32> ranks;
+    if (!state.isValid() || k <= 0) {
+        return ranks;
+    }
+
+    // 每次取出最大值后把区间一分为二，候选区间最多 k + 1 个，线性选择即可
+    struct Range {
+        quint32 first;
+        quint32 last;   // 不含
+        quint32 best;
+    };
+    QList<Range> ranges;
+    ranges.reserve(k + 1);
+    ranges.append(Range{state.first, state.first + state.count,
+                        maxRank(state.first, state.first + state.count)});
+
+    ranks.reserve(k);
+    while (ranks.size() < k && !ranges.isEmpty()) {
+        qsizetype top = 0;
+        for (qsizetype i = 1; i < ranges.size(); ++i) {
+            if (higher(ranges.at(i).best, ranges.at(top).best)) {
+                top = i;
+            }
+        }
+
+        const Range range = ranges.at(top);
+        ranges.removeAt(top);
+        ranks.append(range.best);
+
+        if (range.first < range.best) {
+            ranges.append(Range{range.first, range.best, maxRank(range.first, range.best)});
+        }
+        if (range.best + 1 < range.last) {
+            ranges.append(Range{range.best + 1, range.last, maxRank(range.best + 1, range.last)});
+        }
+    }
+    return ranks;
+}
+
+QString EnglishDawg::wordAt(quint32 rank) const
+{
+    QString word;
+    State state = root();
+    if (rank >= state.count) {
+        return word;
+    }
+
+    while (state.edge != NoEdge) {
+        if (state.final) {
+            if (rank == 0) {
+                break;
+            }
+            --rank;
+        }
+
+        for (quint32 i = state.edge; ; ++i) {
+            const Edge &edge = m_edges[i];
+            if (rank < edge.count) {
+                word.append(QChar(edge.letter));
+                state.edge = edge.target;
+                state.final = edge.flags & FinalEdge;
+                break;
+            }
+            rank -= edge.count;
+        }
+    }
+    return word;
+}
+
+quint32 EnglishDawg::maxRank(quint32 first, quint32 last) const
+{
+    // 自底向上的区间最大值查询，[first, last)
+    quint32 best = NoEdge;
+    quint32 lo = first + m_header->treeLeaves;
+    quint32 hi = last + m_header->treeLeaves;
+    while (lo < hi) {
+        if (lo & 1) {
+            if (higher(m_tree[lo], best)) {
+                best = m_tree[lo];
+            }
+            ++lo;
+        }
+        if (hi & 1) {
+            --hi;
+            if (higher(m_tree[hi], best)) {
+                best = m_tree[hi];
+            }
+        }
+        lo >>= 1;
+        hi >>= 1;
+    }
+    return best;
+}
+
+bool EnglishDawg::higher(quint32 a, quint32 b) const
+{
+    // 词频高者优先，相同时字典序靠前者优先
+    if (a == NoEdge) {
+        return false;
+    }
+    if (b == NoEdge) {
+        return true;
+    }
+    return m_frequencies[a] != m_frequencies[b] ? m_frequencies[a] > m_frequencies[b] : a < b;
+}
@@ -0,0 +1,101 @@
+/**********************************************************
+ * English DAWG - minimized word graph for completion
+ * 英文最小化词图（前缀补全与排序）
+ **********************************************************/
+
+#ifndef ENGLISHDAWG_H
+#define ENGLISHDAWG_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QString>
+#include <QStringView>
+
+class EnglishLexicon;
+
+// 最小化有向无环词图（DAWG）
+// 整个词图是一块连续的只读内存：头部 + 边数组 + 按字典序排列的词频 + 词频线段树。
+// 内存中构建与从文件映射共用同一布局，因此可以离线生成后直接 mmap 使用。
+// 每条边记录其下的单词数，前缀对应的单词在字典序中是一段连续区间，
+// 排名前 K 的补全由线段树在该区间上逐个取最大值得到。
+class EnglishDawg
+{
+public:
+    // 逐键下降的状态：当前结点及其前缀覆盖的单词区间
+    struct State {
+        quint32 edge = NoEdge;   // 当前结点的第一条出边
+        quint32 first = 0;       // 区间起点（字典序排名）
+        quint32 count = 0;       // 区间内单词数，0 表示前缀不存在
+        bool final = false;      // 前缀本身是否为单词（排在区间首位）
+
+        bool isValid() const { return count > 0; }
+    };
+
+    static EnglishDawg &instance();
+
+    // 由词库构建（默认使用英文词库的当前内容）
+    void build(const EnglishLexicon &lexicon);
+
+    // 保存 / 映射词图文件，映射后不再占用堆内存
+    // 重建或加载会使之前得到的 State 失效，应在启动时调用
+    bool saveToFile(const QString &path) const;
+    bool loadFromFile(const QString &path);
+
+    quint32 wordCount() const { return m_header ? m_header->wordCount : 0; }
+
+    State root() const;
+    State advance(const State &state, QChar letter) const;
+
+    // 区间内词频最高的 k 个单词的排名，按词频降序
+    QList<quint32> topRanks(const State &state, int k) const;
+
+    // 按排名还原单词
+    QString wordAt(quint32 rank) const;
+
+private:
+    EnglishDawg();
+    Q_DISABLE_COPY(EnglishDawg)
+
+    static constexpr quint32 NoEdge = 0xffffffffu;
+    static constexpr quint32 Magic = 0x47574144u;   // "DAWG"
+    static constexpr quint32 Version = 1;
+
+    struct Header {
+        quint32 magic;
+        quint32 version;
+        quint32 edgeCount;
+        quint32 wordCount;
+        quint32 rootEdge;
+        quint32 treeLeaves;   // 线段树叶子数（2 的幂）
+    };
+
+    enum EdgeFlag : quint16 {
+        FinalEdge = 0x1,   // 目标结点是单词结尾
+        LastEdge = 0x2     // 结点的最后一条出边
+    };
+
+    struct Edge {
+        quint32 target;   // 目标结点的第一条出边，NoEdge 表示没有出边
+        quint32 count;    // 目标结点下的单词数（含目标结点本身）
+        char16_t letter;
+        quint16 flags;
+    };
+
+    static qint64 imageSize(const Header &header);
+    static bool isValidHeader(const uchar *data, qint64 size);
+    static bool isValidImage(const uchar *data, qint64 size);
+    bool attach(const uchar *data, qint64 size);
+    quint32 maxRank(quint32 first, quint32 last) const;
+    bool higher(quint32 a, quint32 b) const;
+
+    const Header *m_header;
+    const Edge *m_edges;
+    const quint32 *m_frequencies;   // 按排名
+    const quint32 *m_tree;          // 区间最大词频的排名
+
+    QByteArray m_image;   // 内存中构建的词图
+    QFile m_file;         // 映射的词图文件
+};
+
+#endif // ENGLISHDAWG_H
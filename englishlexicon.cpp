@@ -0,0 +1,224 @@
+/**********************************************************
+ * English Lexicon Implementation
+ * 英文词库实现
+ **********************************************************/
+
+#include "englishlexicon.h"
+#include "englishdawg.h"
+#include <QFile>
+#include <QTextStream>
+#include <algorithm>
+
+// 内置常用词，按使用频率从高到低排列
+static const char *const kBuiltinWords[] = {
+    "the", "of", "and", "to", "a", "in", "is", "you", "that", "it",
+    "he", "was", "for", "on", "are", "as", "with", "his", "they", "i",
+    "at", "be", "this", "have", "from", "or", "one", "had", "by", "word",
+    "but", "not", "what", "all", "were", "we", "when", "your", "can", "said",
+    "there", "use", "an", "each", "which", "she", "do", "how", "their", "if",
+    "will", "up", "other", "about", "out", "many", "then", "them", "these", "so",
+    "some", "her", "would", "make", "like", "him", "into", "time", "has", "look",
+    "two", "more", "write", "go", "see", "number", "no", "way", "could", "people",
+    "my", "than", "first", "water", "been", "call", "who", "oil", "its", "now",
+    "find", "long", "down", "day", "did", "get", "come", "made", "may", "part",
+    "new", "name", "address", "street", "road", "city", "state", "country", "phone", "email",
+    "date", "order", "product", "price", "quantity", "total", "customer", "company", "account", "code",
+    "please", "thank", "thanks", "hello", "yes", "okay", "good", "great", "help", "work",
+    "home", "office", "store", "market", "center", "station", "airport", "hotel", "hospital", "school",
+    "north", "south", "east", "west", "left", "right", "next", "last", "today", "tomorrow",
+    "morning", "evening", "night", "week", "month", "year", "hour", "minute", "second", "open",
+    "close", "start", "stop", "send", "receive", "check", "confirm", "cancel", "delete", "save",
+    "search", "service", "support", "system", "information", "message", "report", "record", "item", "list",
+    "after", "before", "where", "why", "because", "over", "under", "again", "also", "back",
+    "just", "know", "take", "year", "only", "little", "very", "through", "much", "before",
+    "line", "same", "tell", "does", "set", "three", "want", "air", "well", "play",
+    "small", "end", "put", "read", "hand", "port", "large", "spell", "add", "even",
+    "land", "here", "must", "big", "high", "such", "follow", "act", "ask", "men",
+    "change", "went", "light", "kind", "off", "need", "house", "picture", "try", "us",
+    "again", "animal", "point", "mother", "world", "near", "build", "self", "earth", "father",
+    "head", "stand", "own", "page", "should", "found", "answer", "grow", "study", "still",
+    "learn", "plant", "cover", "food", "sun", "four", "between", "keep", "eye", "never",
+    "thought", "let", "tree", "cross", "farm", "hard", "draw", "late", "run", "while",
+    "press", "real", "life", "few", "light", "car", "feet", "care", "book", "carry",
+    "took", "science", "eat", "room", "friend", "began", "idea", "fish", "mountain", "once",
+    "base", "hear", "horse", "cut", "sure", "watch", "color", "face", "wood", "main",
+    "enough", "plain", "girl", "usual", "young", "ready", "above", "ever", "red", "list",
+    "though", "feel", "talk", "bird", "soon", "body", "dog", "family", "direct", "pose",
+    "leave", "song", "measure", "door", "black", "short", "class", "wind", "question", "happen",
+    "complete", "ship", "area", "half", "rock", "fire", "problem", "piece", "told", "knew",
+    "pass", "since", "top", "whole", "king", "space", "heard", "best", "better", "true",
+    "during", "hundred", "five", "remember", "step", "early", "hold", "ground", "interest", "reach",
+    "fast", "verb", "sing", "listen", "six", "table", "travel", "less", "ten", "simple",
+    "several", "toward", "war", "lay", "against", "pattern", "slow", "money", "map", "rain",
+    "rule", "pull", "cold", "notice", "voice", "unit", "power", "town", "fine", "drive",
+    "payment", "invoice", "delivery", "shipping", "warehouse", "building", "floor", "district", "province", "zip",
+};
+
+// 下一个词预测表：前一个词 -> 常见的后续词（空格分隔）
+struct EnglishSuccessorSource {
+    const char16_t *word;
+    const char16_t *successors;
+};
+
+static const EnglishSuccessorSource kEnglishSuccessorTable[] = {
+    {u"thank", u"you"},
+    {u"thanks", u"for a again"},
+    {u"please", u"check confirm send call help"},
+    {u"good", u"morning evening night day"},
+    {u"see", u"you the"},
+    {u"i", u"am have will need want can"},
+    {u"we", u"are will have need can"},
+    {u"you", u"can are have will"},
+    {u"can", u"you i we be"},
+    {u"will", u"be have"},
+    {u"this", u"is week month year order"},
+    {u"the", u"order product customer address city number"},
+    {u"order", u"number date total status"},
+    {u"phone", u"number"},
+    {u"email", u"address"},
+    {u"street", u"address"},
+    {u"zip", u"code"},
+    {u"product", u"code name price list"},
+    {u"account", u"number name"},
+    {u"customer", u"name service number"},
+    {u"delivery", u"date address"},
+    {u"shipping", u"address date"},
+    {u"next", u"week month day year"},
+    {u"last", u"week month day year name"},
+    {u"in", u"the stock a"},
+    {u"of", u"the a"},
+    {u"to", u"the be"},
+    {u"for", u"the you your"},
+    {u"on", u"the"},
+    {u"at", u"the"},
+    {u"how", u"are many much"},
+    {u"what", u"is are"},
+    {u"is", u"the a not"},
+    {u"are", u"you the"},
+    {u"hello", u"world"},
+    {u"first", u"name"},
+};
+
+EnglishLexicon &EnglishLexicon::instance()
+{
+    static EnglishLexicon lexicon;
+    return lexicon;
+}
+
+EnglishLexicon::EnglishLexicon()
+    : m_maxFrequency(0)
+    , m_revision(0)
+{
+    const quint32 count = quint32(sizeof(kBuiltinWords) / sizeof(kBuiltinWords[0]));
+    m_words.reserve(count);
+
+    // 词频按排名递减，重复出现的词保留靠前的一个
+    for (quint32 i = 0; i < count; ++i) {
+        addWord(QString::fromLatin1(kBuiltinWords[i]), count - i);
+    }
+
+    const qsizetype successorSize = sizeof(kEnglishSuccessorTable) / sizeof(kEnglishSuccessorTable[0]);
+    m_successors.reserve(successorSize);
+    for (const EnglishSuccessorSource &source : kEnglishSuccessorTable) {
+        SuccessorEntry entry{QStringView(source.word), m_successorWords.size(), 0};
+        entry.count = splitCandidates(source.successors, &m_successorWords);
+        m_successors.append(entry);
+    }
+
+    std::sort(m_successors.begin(), m_successors.end(),
+              [](const SuccessorEntry &a, const SuccessorEntry &b) {
+        return a.word < b.word;
+    });
+}
+
+bool EnglishLexicon::loadFromFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qWarning("EnglishLexicon: cannot open %s", qPrintable(path));
+        return false;
+    }
+
+    clear();
+
+    QTextStream stream(&file);
+    QList<QString> lines;
+    while (!stream.atEnd()) {
+        const QString line = stream.readLine().trimmed();
+        if (!line.isEmpty() && !line.startsWith(u'#')) {
+            lines.append(line);
+        }
+    }
+
+    m_words.reserve(lines.size());
+    quint32 rank = quint32(lines.size());
+    for (const QString &line : std::as_const(lines)) {
+        const qsizetype space = line.indexOf(u' ');
+        const QStringView word = space < 0 ? QStringView(line) : QStringView(line).left(space);
+
+        bool ok = false;
+        quint32 frequency = space < 0 ? 0 : QStringView(line).mid(space + 1).trimmed().toUInt(&ok);
+        if (!ok) {
+            frequency = rank;
+        }
+        --rank;
+
+        addWord(word, frequency);
+    }
+
+    m_pool.squeeze();
+
+    // 补全用的词图按新词库重建，滑行输入的索引由版本号发现过期
+    ++m_revision;
+    EnglishDawg::instance().build(*this);
+    return true;
+}
+
+QStringView EnglishLexicon::word(qsizetype index) const
+{
+    const Entry &entry = m_words.at(index);
+    return QStringView(m_pool).mid(entry.offset, entry.length);
+}
+
+CandidateList EnglishLexicon::successors(QStringView word) const
+{
+    // 表中均为小写，按小写排序；忽略大小写比较与该顺序一致，无需复制输入
+    auto it = std::lower_bound(m_successors.cbegin(), m_successors.cend(), word,
+                               [](const SuccessorEntry &entry, QStringView key) {
+        return entry.word.compare(key, Qt::CaseInsensitive) < 0;
+    });
+
+    if (it == m_successors.cend() || it->word.compare(word, Qt::CaseInsensitive) != 0) {
+        return CandidateList();
+    }
+
+    const QStringView *first = m_successorWords.constData() + it->first;
+    return CandidateList(first, first + it->count);
+}
+
+void EnglishLexicon::clear()
+{
+    m_pool.clear();
+    m_words.clear();
+    m_maxFrequency = 0;
+}
+
+void EnglishLexicon::addWord(QStringView word, quint32 frequency)
+{
+    if (word.isEmpty()) {
+        return;
+    }
+
+    // 内置词表很小，线性去重即可；外部词表假定已去重
+    if (m_words.size() < 1024) {
+        for (qsizetype i = 0; i < m_words.size(); ++i) {
+            if (this->word(i).compare(word, Qt::CaseInsensitive) == 0) {
+                return;
+            }
+        }
+    }
+
+    m_words.append(Entry{m_pool.size(), word.size(), frequency});
+    m_pool.append(word.toString().toLower());
+    m_maxFrequency = qMax(m_maxFrequency, frequency);
+}
@@ -0,0 +1,64 @@
+/**********************************************************
+ * English Lexicon - word list with frequencies
+ * 英文词库（单词及词频）
+ **********************************************************/
+
+#ifndef ENGLISHLEXICON_H
+#define ENGLISHLEXICON_H
+
+#include <QString>
+#include <QStringView>
+#include <QList>
+
+#include "pinyindict.h"
+
+// 英文词库 - 所有单词存放在同一个字符串池中，以视图形式返回
+class EnglishLexicon
+{
+public:
+    static EnglishLexicon &instance();
+
+    // 从文本文件加载词库：每行 "单词 [词频]"，省略词频时按行序递减
+    // 加载会使之前返回的视图失效，应在启动时调用；加载后英文词图随之重建
+    bool loadFromFile(const QString &path);
+
+    // 词库版本，每次加载递增；依赖词序号的索引（如滑行输入）据此判断是否需要重建
+    quint32 revision() const { return m_revision; }
+
+    qsizetype size() const { return m_words.size(); }
+    QStringView word(qsizetype index) const;
+    quint32 frequency(qsizetype index) const { return m_words.at(index).frequency; }
+    quint32 maxFrequency() const { return m_maxFrequency; }
+
+    // 下一个词预测：某个词之后常出现的词，不分配内存
+    CandidateList successors(QStringView word) const;
+
+private:
+    EnglishLexicon();
+    Q_DISABLE_COPY(EnglishLexicon)
+
+    void clear();
+    void addWord(QStringView word, quint32 frequency);
+
+    struct Entry {
+        qsizetype offset;   // m_pool 中的位置
+        qsizetype length;
+        quint32 frequency;
+    };
+
+    struct SuccessorEntry {
+        QStringView word;
+        qsizetype first;   // m_successorWords 中的起始下标
+        qsizetype count;
+    };
+
+    QString m_pool;
+    QList<Entry> m_words;
+    quint32 m_maxFrequency;
+    quint32 m_revision;
+
+    QList<SuccessorEntry> m_successors;   // 按前一个词排序
+    QList<QStringView> m_successorWords;  // 指向静态字符串表
+};
+
+#endif // ENGLISHLEXICON_H
@@ -0,0 +1,249 @@
+/**********************************************************
+ * Gesture Decoder Implementation
+ * 滑行输入解码实现
+ **********************************************************/
+
+#include "gesturedecoder.h"
+#include "englishlexicon.h"
+#include <QLineF>
+#include <QtMath>
+#include <algorithm>
+#include <limits>
+
+// 超过该长度的单词不参与滑行输入
+static const int kMaxWordLength = 32;
+
+// 起止点附近多远的按键可作为首/尾字母（键宽倍数）
+static const qreal kEndpointRadius = 1.2;
+
+// 路径长度容差：绝对值（键宽）与相对比例取较大者
+static const qreal kLengthSlack = 1.5;
+static const qreal kLengthRatio = 0.35;
+
+// 词频在总代价中的权重
+static const qreal kFrequencyWeight = 0.1;
+
+GestureDecoder::GestureDecoder()
+    : m_keyWidth(0)
+    , m_revision(0)
+{
+    for (int i = 0; i < 26; ++i) {
+        m_present[i] = false;
+    }
+    std::fill(std::begin(m_bucketStart), std::end(m_bucketStart), 0u);
+}
+
+void GestureDecoder::setKeyboard(const KeySpatialModel &model)
+{
+    m_shapes.clear();
+    std::fill(std::begin(m_bucketStart), std::end(m_bucketStart), 0u);
+
+    m_keyWidth = model.averageKeyWidth();
+    m_revision = EnglishLexicon::instance().revision();
+    for (int i = 0; i < 26; ++i) {
+        m_present[i] = model.hasKey(i);
+        if (m_present[i]) {
+            m_centers[i] = model.keyCenter(i);
+        }
+    }
+    if (m_keyWidth <= 0) {
+        return;
+    }
+
+    // 先计算每个单词的桶与路径长度，再按 (桶, 长度) 排序
+    struct Pending {
+        int bucket;
+        Shape shape;
+    };
+    const EnglishLexicon &lexicon = EnglishLexicon::instance();
+    QList<Pending> pending;
+    pending.reserve(lexicon.size());
+
+    QPointF path[kMaxWordLength];
+    for (qsizetype i = 0; i < lexicon.size(); ++i) {
+        const QStringView word = lexicon.word(i);
+        const int count = keyPath(word, path);
+        if (count < 2) {
+            continue;
+        }
+
+        const int bucket = bucketOf(word.front().unicode() - u'a', word.back().unicode() - u'a');
+        pending.append(Pending{bucket, Shape{quint32(i), float(pathLength(path, count) / m_keyWidth)}});
+    }
+
+    std::sort(pending.begin(), pending.end(), [](const Pending &a, const Pending &b) {
+        return a.bucket != b.bucket ? a.bucket < b.bucket : a.shape.length < b.shape.length;
+    });
+
+    m_shapes.reserve(pending.size());
+    for (const Pending &item : std::as_const(pending)) {
+        ++m_bucketStart[item.bucket + 1];
+        m_shapes.append(item.shape);
+    }
+    for (int i = 0; i < 26 * 26; ++i) {
+        m_bucketStart[i + 1] += m_bucketStart[i];
+    }
+}
+
+bool GestureDecoder::isStale() const
+{
+    return m_revision != EnglishLexicon::instance().revision();
+}
+
+QList<QStringView> GestureDecoder::decode(const QList<QPointF> &points, int maxResults) const
+{
+    QList<QStringView> results;
+    if (points.size() < 2 || m_shapes.isEmpty() || maxResults <= 0 || isStale()) {
+        return results;
+    }
+
+    const EnglishLexicon &lexicon = EnglishLexicon::instance();
+    const qreal gestureLength = pathLength(points.constData(), int(points.size())) / m_keyWidth;
+    const qreal slack = qMax(kLengthSlack, gestureLength * kLengthRatio);
+
+    QPointF gesture[SampleCount];
+    resample(points.constData(), int(points.size()), gesture);
+
+    // 起止点附近的按键
+    int firsts[26];
+    int lasts[26];
+    int firstCount = 0;
+    int lastCount = 0;
+    const qreal radius = kEndpointRadius * m_keyWidth;
+    for (int i = 0; i < 26; ++i) {
+        if (!m_present[i]) {
+            continue;
+        }
+        if (QLineF(m_centers[i], points.first()).length() <= radius) {
+            firsts[firstCount++] = i;
+        }
+        if (QLineF(m_centers[i], points.last()).length() <= radius) {
+            lasts[lastCount++] = i;
+        }
+    }
+
+    // 当前最好的若干个结果，按代价升序
+    struct Match {
+        qreal cost;
+        quint32 word;
+    };
+    QList<Match> best;
+    best.reserve(maxResults + 1);
+
+    const qreal logMax = qLn(qMax<quint32>(lexicon.maxFrequency(), 1));
+    QPointF path[kMaxWordLength];
+    QPointF shape[SampleCount];
+
+    for (int f = 0; f < firstCount; ++f) {
+        for (int l = 0; l < lastCount; ++l) {
+            const int bucket = bucketOf(firsts[f], lasts[l]);
+            const auto begin = m_shapes.cbegin() + m_bucketStart[bucket];
+            const auto end = m_shapes.cbegin() + m_bucketStart[bucket + 1];
+
+            // 桶内按长度有序，二分截取长度相近的区间
+            const auto lower = std::lower_bound(begin, end, gestureLength - slack,
+                                                [](const Shape &s, qreal v) { return s.length < v; });
+            for (auto it = lower; it != end && it->length <= gestureLength + slack; ++it) {
+                const qreal frequencyCost = kFrequencyWeight
+                        * (logMax - qLn(qMax<quint32>(lexicon.frequency(it->word), 1)));
+                const bool full = best.size() >= maxResults;
+                if (full && frequencyCost >= best.last().cost) {
+                    continue;
+                }
+
+                // 超过此距离总和即不可能进入前 K 名
+                const qreal limit = full ? (best.last().cost - frequencyCost) * m_keyWidth * SampleCount
+                                         : std::numeric_limits<qreal>::max();
+
+                const int count = keyPath(lexicon.word(it->word), path);
+                resample(path, count, shape);
+
+                qreal distance = 0;
+                int i = 0;
+                for (; i < SampleCount && distance < limit; ++i) {
+                    distance += QLineF(gesture[i], shape[i]).length();
+                }
+                if (i < SampleCount || distance >= limit) {
+                    continue;
+                }
+
+                const Match match{distance / SampleCount / m_keyWidth + frequencyCost, it->word};
+                auto pos = std::upper_bound(best.begin(), best.end(), match.cost,
+                                            [](qreal v, const Match &m) { return v < m.cost; });
+                best.insert(pos, match);
+                if (best.size() > maxResults) {
+                    best.removeLast();
+                }
+            }
+        }
+    }
+
+    results.reserve(best.size());
+    for (const Match &match : std::as_const(best)) {
+        results.append(lexicon.word(match.word));
+    }
+    return results;
+}
+
+int GestureDecoder::keyPath(QStringView word, QPointF *path) const
+{
+    if (word.size() > kMaxWordLength) {
+        return 0;
+    }
+
+    int count = 0;
+    int previous = -1;
+    for (QChar ch : word) {
+        const int index = ch.unicode() - u'a';
+        if (index < 0 || index >= 26 || !m_present[index]) {
+            return 0;
+        }
+        if (index != previous) {
+            path[count++] = m_centers[index];
+            previous = index;
+        }
+    }
+
+    // 单字母或同一字母重复（如 "aa"）起止于同一键，按两点处理
+    if (count == 1 && word.size() > 1) {
+        path[count++] = path[0];
+    }
+    return count;
+}
+
+qreal GestureDecoder::pathLength(const QPointF *path, int count)
+{
+    qreal length = 0;
+    for (int i = 1; i < count; ++i) {
+        length += QLineF(path[i - 1], path[i]).length();
+    }
+    return length;
+}
+
+void GestureDecoder::resample(const QPointF *path, int count, QPointF *out)
+{
+    // 沿折线等距取 SampleCount 个点
+    const qreal total = pathLength(path, count);
+    if (count < 2 || total <= 0) {
+        for (int i = 0; i < SampleCount; ++i) {
+            out[i] = path[0];
+        }
+        return;
+    }
+
+    const qreal step = total / (SampleCount - 1);
+    int segment = 1;
+    qreal walked = 0;   // 已走过的完整线段长度
+    for (int i = 0; i < SampleCount; ++i) {
+        const qreal target = qMin(step * i, total);
+        qreal length = QLineF(path[segment - 1], path[segment]).length();
+        while (walked + length < target && segment < count - 1) {
+            walked += length;
+            ++segment;
+            length = QLineF(path[segment - 1], path[segment]).length();
+        }
+
+        const qreal t = length > 0 ? qBound<qreal>(0, (target - walked) / length, 1) : 0;
+        out[i] = path[segment - 1] + (path[segment] - path[segment - 1]) * t;
+    }
+}
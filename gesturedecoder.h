@@ -0,0 +1,57 @@
+/**********************************************************
+ * Gesture Decoder - shape writing over the letter keys
+ * 滑行输入解码（按手势轨迹形状匹配英文单词）
+ **********************************************************/
+
+#ifndef GESTUREDECODER_H
+#define GESTUREDECODER_H
+
+#include <QList>
+#include <QPointF>
+#include <QStringView>
+
+#include "keyspatialmodel.h"
+
+// 滑行输入解码器
+// 索引：单词按 (首字母, 尾字母) 分桶，桶内按理想路径长度排序。
+// 解码时只查看起止点附近按键对应的桶，并用二分查找截取长度相近的区间，
+// 剩余单词才生成模板逐点比较，比较中超过当前第 K 名即提前放弃。
+class GestureDecoder
+{
+public:
+    static constexpr int SampleCount = 16;   // 轨迹与模板的重采样点数
+
+    GestureDecoder();
+
+    // 按键盘布局重建索引（布局尺寸变化后调用）
+    void setKeyboard(const KeySpatialModel &model);
+    bool isEmpty() const { return m_shapes.isEmpty(); }
+
+    // 英文词库重新加载后索引中的词序号失效，需重新 setKeyboard()
+    bool isStale() const;
+
+    // 解码手势轨迹（容器坐标），返回最匹配的单词，视图指向英文词库
+    QList<QStringView> decode(const QList<QPointF> &points, int maxResults = 5) const;
+
+private:
+    // 单词的理想路径：依次连接各字母键中心（跳过连续重复字母）
+    int keyPath(QStringView word, QPointF *path) const;
+    static qreal pathLength(const QPointF *path, int count);
+    static void resample(const QPointF *path, int count, QPointF *out);
+
+    static int bucketOf(int first, int last) { return first * 26 + last; }
+
+    struct Shape {
+        quint32 word;   // 英文词库中的序号
+        float length;   // 理想路径长度（以键宽为单位）
+    };
+
+    QList<Shape> m_shapes;              // 按 (桶, 长度) 排序
+    quint32 m_bucketStart[26 * 26 + 1]; // 每个桶在 m_shapes 中的起点
+    QPointF m_centers[26];
+    bool m_present[26];
+    qreal m_keyWidth;
+    quint32 m_revision;   // 建立索引时的词库版本
+};
+
+#endif // GESTUREDECODER_H
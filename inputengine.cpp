@@ -0,0 +1,667 @@
+/**********************************************************
+ * Input Engines Implementation
+ * 输入引擎实现
+ **********************************************************/
+
+#include "inputengine.h"
+#include <algorithm>
+#include <iterator>
+
+// ==================== InputEngine 实现 ====================
+
+QString InputEngine::commit(QStringView candidate)
+{
+    QString text = candidate.toString();
+    reset();
+    return text;
+}
+
+bool InputEngine::feedTouch(QChar key, const KeyGuess &guess)
+{
+    Q_UNUSED(guess);
+    return feed(key);
+}
+
+// ==================== PinyinEngine 实现 ====================
+
+PinyinEngine::PinyinEngine()
+{
+    m_states.reserve(32);
+    m_guesses.reserve(32);
+    m_results.reserve(32);
+    m_states.append(PinyinSyllables::PrefixState());
+    m_results.append(CandidateList());
+    m_queryCache.setMaxCost(QueryCacheSize);
+}
+
+bool PinyinEngine::feed(QChar key)
+{
+    return feedTouch(key, KeyGuess::exact(key));
+}
+
+bool PinyinEngine::feedTouch(QChar key, const KeyGuess &guess)
+{
+    const QChar lower = key.toLower();
+    if (lower < u'a' || lower > u'z') {
+        return false;
+    }
+
+    // 概率中不含实际按键时（例如按键区域与模型不一致）按确定输入处理
+    bool hasKey = false;
+    for (int i = 0; i < guess.count; ++i) {
+        hasKey = hasKey || guess.letters[i] == lower.unicode();
+    }
+
+    // 不合法的输入仍然接收，只做标记，由用户自行删除
+    m_buffer += lower;
+    m_states.append(m_states.last().advance(lower.unicode()));
+    m_guesses.append(hasKey ? guess : KeyGuess::exact(lower));
+    update();
+    m_results.append(m_candidates);
+    return true;
+}
+
+bool PinyinEngine::backspace()
+{
+    if (m_buffer.isEmpty()) {
+        return false;
+    }
+
+    // 恢复上一个前缀已算好的结果，不再查找
+    m_buffer.chop(1);
+    m_states.removeLast();
+    m_guesses.removeLast();
+    m_results.removeLast();
+    m_candidates = m_results.last();
+    return true;
+}
+
+void PinyinEngine::reset()
+{
+    m_buffer.clear();
+    m_states.resize(1);
+    m_guesses.clear();
+    m_results.resize(1);
+    m_candidates = CandidateList();
+}
+
+void PinyinEngine::update()
+{
+    // 已经不可能组成合法拼音时无需查词典；最近查过的拼音直接取缓存（含查不到的）
+    // 压缩词典返回的列表持有解压块，不放入本缓存，以免绕过词典按字节计的缓存上限
+    m_candidates = CandidateList();
+    if (isPreeditValid()) {
+        if (const CandidateList *cached = m_queryCache.object(m_buffer)) {
+            m_candidates = *cached;
+        } else {
+            m_candidates = PinyinDict::instance().lookup(m_buffer);
+            if (!m_candidates.ownsStorage()) {
+                m_queryCache.insert(m_buffer, new CandidateList(m_candidates));
+            }
+        }
+    }
+
+    // 按原样查不到时，按触点概率尝试相邻按键
+    if (m_candidates.isEmpty()) {
+        m_candidates = fuzzyLookup();
+    }
+}
+
+namespace {
+
+struct Beam {
+    PinyinSyllables::PrefixState state;
+    float score;
+    char16_t text[PinyinEngine::MaxFuzzyLength];
+};
+
+} // namespace
+
+CandidateList PinyinEngine::fuzzyLookup() const
+{
+    const int length = int(m_guesses.size());
+    if (length == 0 || length > MaxFuzzyLength) {
+        return CandidateList();
+    }
+
+    // 集束搜索：每步只保留得分最高且仍可组成合法拼音的 BeamWidth 条路径
+    Beam beams[BeamWidth];
+    Beam expanded[BeamWidth * KeyGuess::MaxLetters];
+    int beamCount = 1;
+    beams[0].score = 1.0f;
+
+    for (int pos = 0; pos < length; ++pos) {
+        const KeyGuess &guess = m_guesses.at(pos);
+        int expandedCount = 0;
+
+        for (int b = 0; b < beamCount; ++b) {
+            for (int i = 0; i < guess.count; ++i) {
+                const PinyinSyllables::PrefixState state = beams[b].state.advance(guess.letters[i]);
+                if (!state.isValid()) {
+                    continue;
+                }
+
+                Beam &next = expanded[expandedCount++];
+                next.state = state;
+                next.score = beams[b].score * guess.probabilities[i];
+                std::copy(beams[b].text, beams[b].text + pos, next.text);
+                next.text[pos] = guess.letters[i];
+            }
+        }
+
+        std::sort(expanded, expanded + expandedCount, [](const Beam &a, const Beam &b) {
+            return a.score > b.score;
+        });
+
+        beamCount = qMin(expandedCount, int(BeamWidth));
+        if (beamCount == 0) {
+            return CandidateList();
+        }
+        std::copy(expanded, expanded + beamCount, beams);
+    }
+
+    // 取得分最高且能在词典中查到的拼写
+    for (int b = 0; b < beamCount; ++b) {
+        if (!beams[b].state.isComplete()) {
+            continue;
+        }
+
+        const CandidateList candidates =
+                PinyinDict::instance().lookup(QStringView(beams[b].text, length));
+        if (!candidates.isEmpty()) {
+            return candidates;
+        }
+    }
+
+    return CandidateList();
+}
+
+// ==================== WubiEngine 实现 ====================
+
+namespace {
+
+// 五笔 86 版常用码表（一级简码、二级简码、全码及常用词组）
+struct WubiSource {
+    const char *code;
+    const char16_t *candidates;
+};
+
+const WubiSource kWubiTable[] = {
+    // 一级简码
+    {"g", u"一"}, {"f", u"地"}, {"d", u"在"}, {"s", u"要"}, {"a", u"工"},
+    {"h", u"上"}, {"j", u"是"}, {"k", u"中"}, {"l", u"国"}, {"m", u"同"},
+    {"t", u"和"}, {"r", u"的"}, {"e", u"有"}, {"w", u"人"}, {"q", u"我"},
+    {"y", u"主"}, {"u", u"产"}, {"i", u"不"}, {"o", u"为"}, {"p", u"这"},
+    {"n", u"民"}, {"b", u"了"}, {"v", u"发"}, {"c", u"以"}, {"x", u"经"},
+
+    // 二级简码
+    {"wu", u"们"}, {"ip", u"学"}, {"pe", u"家"}, {"jf", u"时"}, {"tg", u"生"},
+    {"wt", u"作"}, {"fg", u"二"}, {"dg", u"三"}, {"lh", u"四"}, {"gg", u"五"},
+    {"uy", u"六"}, {"ag", u"七"}, {"vt", u"九"}, {"jn", u"电"}, {"kg", u"号"},
+    {"mq", u"见"}, {"gm", u"再"}, {"ux", u"北"}, {"yi", u"就"}, {"dd", u"大"},
+
+    // 全码
+    {"wqiy", u"你"}, {"vbg", u"好"}, {"khk", u"中"}, {"lgyi", u"国"},
+    {"trnt", u"我"}, {"wwww", u"人"}, {"wun", u"们"}, {"dddd", u"大"},
+    {"ihty", u"小"}, {"hhgg", u"上"}, {"ghi", u"下"}, {"jghu", u"是"},
+    {"gii", u"不"}, {"rqyy", u"的"}, {"bnh", u"了"}, {"dhfd", u"在"},
+    {"def", u"有"}, {"tkg", u"和"}, {"fbn", u"地"}, {"aaaa", u"工"},
+    {"wthf", u"作"}, {"peu", u"家"}, {"ipbf", u"学"}, {"tgd", u"生"},
+    {"jfy", u"时"}, {"jjjj", u"日"}, {"eeee", u"月"}, {"iiii", u"水"},
+    {"oooo", u"火"}, {"ssss", u"木"}, {"qqqq", u"金"}, {"ffff", u"土"},
+    {"kkkk", u"口"}, {"mmmm", u"山"}, {"ggll", u"一"}, {"fgh", u"十"},
+    {"ytmf", u"谢"}, {"gmf", u"再"}, {"mqb", u"见"}, {"jnv", u"电"},
+    {"ytdg", u"话"}, {"kgnb", u"号"}, {"ujd", u"间"}, {"nav", u"民"},
+    {"uxn", u"北"}, {"yiu", u"京"}, {"fhg", u"址"},
+
+    // 常用词组（两字词取各字前两码）
+    {"khlg", u"中国"}, {"trwu", u"我们"}, {"wqvb", u"你好"}, {"ytyt", u"谢谢"},
+    {"gmmq", u"再见"}, {"jnyt", u"电话"}, {"fbfh", u"地址"}, {"aawt", u"工作"},
+    {"iptg", u"学生"}, {"jfuj", u"时间"}, {"wwna", u"人民"}, {"uxyi", u"北京"},
+};
+
+// 每键 5 位：a=1 ... z=26，0 表示空
+quint32 packKey(quint32 code, QChar key)
+{
+    return (code << 5) | quint32(key.unicode() - u'a' + 1);
+}
+
+quint32 hashCode(quint32 code, quint32 seed)
+{
+    quint32 h = code * 0x9E3779B1u ^ (seed + 1) * 0x85EBCA6Bu;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    h *= 0x297A2D39u;
+    h ^= h >> 15;
+    return h;
+}
+
+} // namespace
+
+WubiEngine::CodeTable::CodeTable()
+{
+    // 同一编码可能出现多次（简码与全码重码），先按编码归并
+    struct Key {
+        quint32 code;
+        qsizetype first;
+        qsizetype count;
+    };
+    QList<Key> keys;
+
+    QList<const WubiSource *> sources;
+    for (const WubiSource &source : kWubiTable) {
+        sources.append(&source);
+    }
+    std::stable_sort(sources.begin(), sources.end(), [](const WubiSource *a, const WubiSource *b) {
+        return qstrcmp(a->code, b->code) < 0;
+    });
+
+    for (const WubiSource *source : std::as_const(sources)) {
+        quint32 code = 0;
+        for (const char *c = source->code; *c; ++c) {
+            code = packKey(code, QLatin1Char(*c));
+        }
+
+        if (keys.isEmpty() || keys.last().code != code) {
+            keys.append(Key{code, m_candidates.size(), 0});
+        }
+        keys.last().count += splitCandidates(source->candidates, &m_candidates);
+    }
+
+    // 哈希-位移法构造最小完美哈希：先分桶，再为每个桶寻找使其全部落入空槽的种子
+    const qsizetype keyCount = keys.size();
+    const qsizetype bucketCount = qMax<qsizetype>(1, keyCount / 4);
+
+    QList<QList<qsizetype>> buckets(bucketCount);
+    for (qsizetype i = 0; i < keyCount; ++i) {
+        buckets[hashCode(keys[i].code, 0) % bucketCount].append(i);
+    }
+
+    QList<qsizetype> order(bucketCount);
+    for (qsizetype i = 0; i < bucketCount; ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&buckets](qsizetype a, qsizetype b) {
+        return buckets[a].size() > buckets[b].size();
+    });
+
+    m_slots = QList<Slot>(keyCount, Slot{0, 0, 0});
+    m_seeds = QList<quint32>(bucketCount, 0);
+    QList<bool> used(keyCount, false);
+    QList<qsizetype> placed;
+
+    for (qsizetype bucket : std::as_const(order)) {
+        const QList<qsizetype> &members = buckets[bucket];
+        if (members.isEmpty()) {
+            continue;
+        }
+
+        for (quint32 seed = 1; ; ++seed) {
+            placed.clear();
+            for (qsizetype key : members) {
+                const qsizetype slot = hashCode(keys[key].code, seed) % keyCount;
+                if (used[slot] || placed.contains(slot)) {
+                    break;
+                }
+                placed.append(slot);
+            }
+
+            if (placed.size() == members.size()) {
+                for (qsizetype i = 0; i < members.size(); ++i) {
+                    const Key &key = keys[members[i]];
+                    used[placed[i]] = true;
+                    m_slots[placed[i]] = Slot{key.code, key.first, key.count};
+                }
+                m_seeds[bucket] = seed;
+                break;
+            }
+        }
+    }
+}
+
+CandidateList WubiEngine::CodeTable::find(quint32 code) const
+{
+    if (m_slots.isEmpty()) {
+        return CandidateList();
+    }
+
+    const quint32 seed = m_seeds[hashCode(code, 0) % m_seeds.size()];
+    const Slot &slot = m_slots[hashCode(code, seed) % m_slots.size()];
+
+    // 不在码表中的编码也会落到某个槽，需比对编码
+    if (slot.code != code) {
+        return CandidateList();
+    }
+
+    const QStringView *first = m_candidates.constData() + slot.first;
+    return CandidateList(first, first + slot.count);
+}
+
+const WubiEngine::CodeTable &WubiEngine::codeTable()
+{
+    static const CodeTable table;
+    return table;
+}
+
+WubiEngine::WubiEngine()
+    : m_code(0)
+{
+}
+
+bool WubiEngine::feed(QChar key)
+{
+    // 五笔只使用 a-y，z 为学习键
+    const QChar lower = key.toLower();
+    if (lower < u'a' || lower > u'y') {
+        return false;
+    }
+
+    // 四码已满时顶字上屏：首选上屏（空码直接清除），该键开始新的编码
+    if (m_buffer.size() >= MaxCodeLength) {
+        if (!m_candidates.isEmpty()) {
+            m_committed += m_candidates.at(0);
+        }
+        reset();
+    }
+
+    m_buffer += lower;
+    m_code = packKey(m_code, lower);
+    update();
+
+    // 四码唯一候选直接上屏
+    if (m_buffer.size() == MaxCodeLength && m_candidates.size() == 1) {
+        m_committed += m_candidates.at(0);
+        reset();
+    }
+    return true;
+}
+
+bool WubiEngine::backspace()
+{
+    if (m_buffer.isEmpty()) {
+        return false;
+    }
+
+    m_buffer.chop(1);
+    m_code >>= 5;
+    update();
+    return true;
+}
+
+void WubiEngine::reset()
+{
+    m_buffer.clear();
+    m_code = 0;
+    m_candidates = CandidateList();
+}
+
+void WubiEngine::update()
+{
+    m_candidates = codeTable().find(m_code);
+}
+
+// ==================== ShuangpinEngine 实现 ====================
+
+namespace {
+
+// 双拼方案：各键对应的韵母（空格分隔，同一声母下先列出的优先），及零声母音节的键位
+struct ShuangpinSource {
+    const char *finals[ShuangpinEngine::KeyCount];
+    const char *zeroInitial;   // "键键=音节"，空格分隔
+};
+
+const ShuangpinSource kShuangpinSchemes[] = {
+    // 微软双拼：零声母统一以 o 开头
+    {
+        {"a", "ou", "iao", "uang iang", "e", "en", "eng", "ang", "i", "an", "ao", "ai", "ian",
+         "in", "uo o", "un", "iu", "uan er", "ong iong", "ue", "u", "ui ve", "ia ua", "ie",
+         "uai v", "ei", "ing"},
+        "oa=a oo=o oe=e ol=ai oz=ei ok=ao ob=ou oj=an of=en oh=ang og=eng or=er"
+    },
+    // 自然码：零声母以韵母首字母开头，再按韵母所在键
+    {
+        {"a", "ou", "iao", "uang iang", "e", "en", "eng", "ang", "i", "an", "ao", "ai", "ian",
+         "in", "uo o", "un", "iu", "uan", "ong iong", "ue ve", "u", "ui v", "ia ua", "ie",
+         "uai ing", "ei", nullptr},
+        "aa=a oo=o ee=e al=ai ez=ei ak=ao ob=ou aj=an ef=en ah=ang eg=eng er=er"
+    },
+    // 小鹤双拼：零声母单字母韵母双击，双字母韵母直接输入，ang/eng 为 ah/eg
+    {
+        {"a", "in", "ao", "ai", "e", "en", "eng", "ang", "i", "an", "uai ing", "uang iang", "ian",
+         "iao", "uo o", "ie", "iu", "uan", "ong iong", "ue ve", "u", "ui v", "ei", "ia ua",
+         "un", "ou", nullptr},
+        "aa=a oo=o ee=e ai=ai ei=ei ao=ao ou=ou an=an en=en ah=ang eg=eng er=er"
+    },
+};
+
+// 单字母声母（各方案相同），zh/ch/sh 分别在 v/i/u 键
+const char *const kConsonants[] = {
+    "b", "c", "d", "f", "g", "h", "j", "k", "l", "m", "n", "p", "q", "r", "s", "t",
+    "w", "x", "y", "z",
+};
+
+#ifndef QT_NO_DEBUG
+// 各方案已知的键位与音节，构建键表后逐一核对（"键键=音节"，空格分隔）
+const char *const kShuangpinSamples[] = {
+    "bz=bei xw=xia gw=gua x;=xing vs=zhong ol=ai",
+    "bz=bei xw=xia gw=gua xy=xing vs=zhong al=ai",
+    "bw=bei xx=xia gx=gua xk=xing vs=zhong ai=ai",
+};
+#endif
+
+} // namespace
+
+ShuangpinEngine::KeyTable::KeyTable(Scheme scheme)
+{
+    const ShuangpinSource &source = kShuangpinSchemes[scheme];
+
+    for (int i = 0; i < KeyCount; ++i) {
+        std::fill(std::begin(m_pairs[i]), std::end(m_pairs[i]), qint16(-1));
+        m_lead[i] = false;
+        m_initials[i] = "";
+    }
+    for (const char *consonant : kConsonants) {
+        m_initials[consonant[0] - 'a'] = consonant;
+    }
+    m_initials['v' - 'a'] = "zh";
+    m_initials['i' - 'a'] = "ch";
+    m_initials['u' - 'a'] = "sh";
+
+    // 声母键 x 韵母键：拼出的音节合法才填入
+    char spelling[8];
+    for (int first = 0; first < KeyCount; ++first) {
+        const int initialLength = int(qstrlen(m_initials[first]));
+        if (initialLength == 0) {
+            continue;
+        }
+        m_lead[first] = true;
+
+        for (int second = 0; second < KeyCount; ++second) {
+            for (const char *f = source.finals[second]; f && *f && m_pairs[first][second] < 0; ) {
+                int length = 0;
+                while (f[length] && f[length] != ' ') {
+                    ++length;
+                }
+
+                std::copy(m_initials[first], m_initials[first] + initialLength, spelling);
+                std::copy(f, f + length, spelling + initialLength);
+                m_pairs[first][second] = qint16(PinyinSyllables::indexOf(spelling, initialLength + length));
+
+                f += length;
+                while (*f == ' ') {
+                    ++f;
+                }
+            }
+        }
+    }
+
+    // 零声母音节
+    for (const char *z = source.zeroInitial; *z; ) {
+        const int first = z[0] - 'a';
+        const int second = z[1] - 'a';
+        int length = 0;
+        while (z[3 + length] && z[3 + length] != ' ') {
+            ++length;
+        }
+
+        m_pairs[first][second] = qint16(PinyinSyllables::indexOf(z + 3, length));
+        m_lead[first] = true;
+
+        z += 3 + length;
+        while (*z == ' ') {
+            ++z;
+        }
+    }
+}
+
+const ShuangpinEngine::KeyTable &ShuangpinEngine::keyTable(Scheme scheme)
+{
+    static const KeyTable tables[] = {KeyTable(Microsoft), KeyTable(Ziranma), KeyTable(Xiaohe)};
+#ifndef QT_NO_DEBUG
+    // 调试构建中首次使用时核对各方案的已知键位，防止韵母表错位
+    static const bool checked = [] {
+        for (int i = 0; i < int(std::size(tables)); ++i) {
+            for (const char *s = kShuangpinSamples[i]; *s; ) {
+                int length = 0;
+                while (s[3 + length] && s[3 + length] != ' ') {
+                    ++length;
+                }
+
+                const int expected = PinyinSyllables::indexOf(s + 3, length);
+                Q_ASSERT_X(expected >= 0
+                               && tables[i].syllable(keyIndex(QLatin1Char(s[0])), keyIndex(QLatin1Char(s[1]))) == expected,
+                           "ShuangpinEngine::keyTable", s);
+
+                s += 3 + length;
+                while (*s == ' ') {
+                    ++s;
+                }
+            }
+        }
+        return true;
+    }();
+    Q_UNUSED(checked);
+#endif
+    return tables[scheme];
+}
+
+int ShuangpinEngine::keyIndex(QChar key)
+{
+    const QChar lower = key.toLower();
+    if (lower >= u'a' && lower <= u'z') {
+        return lower.unicode() - u'a';
+    }
+    return lower == u';' ? 26 : -1;
+}
+
+ShuangpinEngine::ShuangpinEngine(Scheme scheme)
+    : m_scheme(scheme)
+    , m_invalidCount(0)
+{
+    m_results.reserve(32);
+    m_results.append(CandidateList());
+}
+
+QString ShuangpinEngine::name() const
+{
+    switch (m_scheme) {
+    case Microsoft:
+        return QStringLiteral("微软双拼");
+    case Ziranma:
+        return QStringLiteral("自然码");
+    case Xiaohe:
+        break;
+    }
+    return QStringLiteral("小鹤双拼");
+}
+
+void ShuangpinEngine::setScheme(Scheme scheme)
+{
+    reset();
+    m_scheme = scheme;
+}
+
+bool ShuangpinEngine::feed(QChar key)
+{
+    // 分号只作为次键（微软双拼的 ing），在音节开头时按普通标点处理
+    const int index = keyIndex(key);
+    if (index < 0 || (index == 26 && m_keys.size() % 2 == 0)) {
+        return false;
+    }
+
+    m_keys += index == 26 ? QChar(u';') : key.toLower();
+
+    // 首键只记录，次键时查表得到整个音节
+    if (m_keys.size() % 2 == 0) {
+        const int first = keyIndex(m_keys.at(m_keys.size() - 2));
+        const qint16 syllable = keyTable(m_scheme).syllable(first, index);
+        if (syllable >= 0) {
+            m_pinyin += QLatin1String(PinyinSyllables::kSyllables[syllable]);
+        } else {
+            m_pinyin += m_keys.right(2);
+            ++m_invalidCount;
+        }
+        m_syllables.append(Syllable{m_pinyin.size(), syllable >= 0});
+        update();
+    }
+
+    m_results.append(m_candidates);
+    return true;
+}
+
+bool ShuangpinEngine::backspace()
+{
+    if (m_keys.isEmpty()) {
+        return false;
+    }
+
+    // 删除次键时撤销整个音节的解码，首键重新变为未完成状态
+    if (m_keys.size() % 2 == 0) {
+        if (!m_syllables.takeLast().valid) {
+            --m_invalidCount;
+        }
+        m_pinyin.truncate(m_syllables.isEmpty() ? 0 : m_syllables.last().end);
+    }
+
+    m_keys.chop(1);
+    m_results.removeLast();
+    m_candidates = m_results.last();
+    return true;
+}
+
+QString ShuangpinEngine::preedit() const
+{
+    if (m_keys.size() % 2 == 0) {
+        return m_pinyin;
+    }
+
+    // 未完成的音节显示其声母，零声母显示按键本身
+    const QChar pending = m_keys.back();
+    const QLatin1String initial = keyTable(m_scheme).initial(keyIndex(pending));
+    return initial.isEmpty() ? m_pinyin + pending : m_pinyin + initial;
+}
+
+bool ShuangpinEngine::isPreeditValid() const
+{
+    if (m_invalidCount > 0) {
+        return false;
+    }
+    return m_keys.size() % 2 == 0 || keyTable(m_scheme).isLeadKey(keyIndex(m_keys.back()));
+}
+
+void ShuangpinEngine::reset()
+{
+    m_keys.clear();
+    m_pinyin.clear();
+    m_syllables.clear();
+    m_invalidCount = 0;
+    m_results.resize(1);
+    m_candidates = CandidateList();
+}
+
+void ShuangpinEngine::update()
+{
+    // 音节已全部解码为全拼，与全拼输入共用词典
+    m_candidates = m_invalidCount == 0 ? PinyinDict::instance().lookup(m_pinyin) : CandidateList();
+}
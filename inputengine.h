@@ -0,0 +1,211 @@
+/**********************************************************
+ * Input Engines - pluggable Chinese input methods
+ * 输入引擎接口（拼音 / 五笔）
+ **********************************************************/
+
+#ifndef INPUTENGINE_H
+#define INPUTENGINE_H
+
+#include <QString>
+#include <QStringView>
+#include <QList>
+#include <QCache>
+#include <QLatin1String>
+#include <utility>
+
+#include "pinyindict.h"
+#include "pinyinsyllables.h"
+#include "keyspatialmodel.h"
+
+// 输入引擎接口 - Keyboard 逐键驱动
+class InputEngine
+{
+public:
+    virtual ~InputEngine() = default;
+
+    // 引擎名称（用于界面显示）
+    virtual QString name() const = 0;
+
+    // 输入一个按键，返回 false 表示引擎不处理该键
+    virtual bool feed(QChar key) = 0;
+
+    // 带触点概率的按键，默认忽略概率
+    virtual bool feedTouch(QChar key, const KeyGuess &guess);
+
+    // 删除一个按键，返回 false 表示当前没有输入
+    virtual bool backspace() = 0;
+
+    // 当前编码（显示在候选栏首位）
+    virtual QString preedit() const = 0;
+
+    // 当前编码对应的候选词
+    virtual CandidateList candidates() const = 0;
+
+    // 当前编码是否仍可能组成合法输入（不合法时界面给出提示）
+    virtual bool isPreeditValid() const { return true; }
+
+    // 结束本次输入
+    virtual void reset() = 0;
+
+    // 上屏选中的候选词，返回需要发送的文本并结束本次输入
+    virtual QString commit(QStringView candidate);
+
+    // 按键过程中引擎自动上屏的文本（如五笔四码唯一、顶字上屏），取出后清空
+    virtual QString takeCommitted() { return QString(); }
+
+    bool isComposing() const { return !preedit().isEmpty(); }
+};
+
+// 全拼输入 - 有状态，每个线程使用各自的实例
+class PinyinEngine : public InputEngine
+{
+public:
+    PinyinEngine();
+
+    QString name() const override { return QStringLiteral("拼音"); }
+
+    bool feed(QChar key) override;
+    bool feedTouch(QChar key, const KeyGuess &guess) override;
+    bool backspace() override;
+    QString preedit() const override { return m_buffer; }
+    CandidateList candidates() const override { return m_candidates; }
+    bool isPreeditValid() const override { return m_states.last().isValid(); }
+    void reset() override;
+
+    // 纠错搜索的参数：超过该长度的输入不再纠错
+    static constexpr int MaxFuzzyLength = 24;
+    static constexpr int BeamWidth = 8;
+
+    // 最近查询过的拼音条数（跨多次输入保留）
+    static constexpr int QueryCacheSize = 128;
+
+private:
+    void update();
+    CandidateList fuzzyLookup() const;
+
+    QString m_buffer;            // 拼音缓冲
+    CandidateList m_candidates;
+    QList<KeyGuess> m_guesses;   // 每个字母的触点概率
+
+    // 每个前缀对应的音节自动机状态，m_states[i] 为前 i 个字母的状态
+    QList<PinyinSyllables::PrefixState> m_states;
+
+    // 每个前缀的查找结果，m_results[i] 为前 i 个字母的候选，删除时直接恢复
+    QList<CandidateList> m_results;
+
+    // 最近查询的拼音 -> 候选（LRU），不含与触点有关的纠错结果及持有解压块的结果
+    QCache<QString, CandidateList> m_queryCache;
+};
+
+// 五笔字型输入 - 编码表使用完美哈希，每次按键 O(1) 查找
+class WubiEngine : public InputEngine
+{
+public:
+    WubiEngine();
+
+    QString name() const override { return QStringLiteral("五笔"); }
+
+    bool feed(QChar key) override;
+    bool backspace() override;
+    QString preedit() const override { return m_buffer; }
+    CandidateList candidates() const override { return m_candidates; }
+    void reset() override;
+    QString takeCommitted() override { return std::exchange(m_committed, QString()); }
+
+    static constexpr int MaxCodeLength = 4;
+
+private:
+    // 码表：a-y 每键 5 位打包成整数，最长 4 键
+    class CodeTable
+    {
+    public:
+        CodeTable();
+        CandidateList find(quint32 code) const;
+
+    private:
+        struct Slot {
+            quint32 code;
+            qsizetype first;
+            qsizetype count;
+        };
+
+        QList<Slot> m_slots;            // 完美哈希槽，与编码一一对应
+        QList<quint32> m_seeds;         // 每个桶的位移种子
+        QList<QStringView> m_candidates;
+    };
+
+    static const CodeTable &codeTable();
+    void update();
+
+    QString m_buffer;   // 已输入的编码
+    quint32 m_code;     // 打包后的编码，随按键增量更新
+    CandidateList m_candidates;
+    QString m_committed;   // 自动上屏、尚未被取走的文本
+};
+
+// 双拼输入 - 每个音节固定两键，按方案的键位表逐键解码为全拼后查词典
+class ShuangpinEngine : public InputEngine
+{
+public:
+    enum Scheme {
+        Microsoft,   // 微软双拼（ing 在分号键）
+        Ziranma,     // 自然码
+        Xiaohe       // 小鹤双拼
+    };
+
+    explicit ShuangpinEngine(Scheme scheme = Xiaohe);
+
+    QString name() const override;
+
+    // 切换方案会结束当前输入
+    void setScheme(Scheme scheme);
+    Scheme scheme() const { return m_scheme; }
+
+    bool feed(QChar key) override;
+    bool backspace() override;
+    QString preedit() const override;
+    CandidateList candidates() const override { return m_candidates; }
+    bool isPreeditValid() const override;
+    void reset() override;
+
+    // 键 0-25 为 a-z，26 为分号
+    static constexpr int KeyCount = 27;
+
+private:
+    // 键位表：首键 x 次键 -> 音节序号（PinyinSyllables::kSyllables），-1 表示不成音节
+    class KeyTable
+    {
+    public:
+        explicit KeyTable(Scheme scheme);
+
+        qint16 syllable(int first, int second) const { return m_pairs[first][second]; }
+
+        // 首键能否开始一个音节，及其对应的声母（用于显示未完成的音节）
+        bool isLeadKey(int key) const { return m_lead[key]; }
+        QLatin1String initial(int key) const { return QLatin1String(m_initials[key]); }
+
+    private:
+        qint16 m_pairs[KeyCount][KeyCount];
+        bool m_lead[KeyCount];
+        const char *m_initials[KeyCount];
+    };
+
+    static const KeyTable &keyTable(Scheme scheme);
+    static int keyIndex(QChar key);
+    void update();
+
+    struct Syllable {
+        qsizetype end;   // 在 m_pinyin 中的结束位置
+        bool valid;
+    };
+
+    Scheme m_scheme;
+    QString m_keys;               // 已输入的按键
+    QString m_pinyin;             // 已完成音节解码出的全拼（不成音节的键对原样保留）
+    QList<Syllable> m_syllables;
+    int m_invalidCount;           // 不成音节的键对数
+    CandidateList m_candidates;
+    QList<CandidateList> m_results;  // m_results[i] 为输入 i 个键后的候选，删除时直接恢复
+};
+
+#endif // INPUTENGINE_H
@@ -6,12 +6,16 @@
 #include "Keyboard.h"
 #include <QApplication>
 #include <QDebug>
-#include <QRegularExpression>
+#include <QLineF>
+#include <QTouchEvent>
+
+#include "englishlexicon.h"
 
 // ==================== ChineseWidget 实现 ====================
 
 ChineseWidget::ChineseWidget(QWidget *parent)
     : QListWidget(parent)
+    , m_visibleCount(0)
 {
     setFocusPolicy(Qt::NoFocus);
     setViewMode(QListView::ListMode);
@@ -42,300 +46,117 @@ ChineseWidget::ChineseWidget(QWidget *parent)
         );
 
     connect(this, &QListWidget::itemClicked, this, &ChineseWidget::onItemClicked);
+}
 
-    loadPinyinDict();
-}
-
-void ChineseWidget::loadPinyinDict()
-{
-    // 简化的拼音词典 - 常用汉字
-    // 格式: 拼音 -> 汉字列表
-    m_pinyinDict["a"] = {"啊", "阿", "呵", "腌"};
-    m_pinyinDict["ai"] = {"爱", "哀", "挨", "碍", "癌", "矮", "艾"};
-    m_pinyinDict["an"] = {"安", "按", "岸", "暗", "案", "鞍", "俺"};
-    m_pinyinDict["ang"] = {"昂", "肮", "盎"};
-
-    m_pinyinDict["ba"] = {"把", "爸", "吧", "八", "巴", "拔", "跋", "霸", "罢", "坝"};
-    m_pinyinDict["bai"] = {"白", "百", "摆", "败", "拜", "柏"};
-    m_pinyinDict["ban"] = {"办", "半", "班", "板", "版", "伴", "扮", "拌", "颁"};
-    m_pinyinDict["bang"] = {"帮", "邦", "棒", "磅", "榜", "绑", "膀", "镑"};
-    m_pinyinDict["bao"] = {"报", "保", "包", "薄", "抱", "暴", "爆", "饱", "宝", "堡"};
-    m_pinyinDict["bei"] = {"被", "北", "备", "背", "倍", "杯", "悲", "碑", "卑"};
-    m_pinyinDict["ben"] = {"本", "奔", "笨", "苯"};
-    m_pinyinDict["beng"] = {"蹦", "崩", "绷", "泵"};
-    m_pinyinDict["bi"] = {"比", "笔", "必", "闭", "彼", "逼", "毕", "鼻", "碧", "壁"};
-    m_pinyinDict["bian"] = {"变", "边", "便", "遍", "编", "辩", "辨", "鞭", "贬"};
-    m_pinyinDict["biao"] = {"表", "标", "彪", "膘", "裱", "镖"};
-    m_pinyinDict["bie"] = {"别", "憋", "瘪"};
-    m_pinyinDict["bin"] = {"宾", "滨", "彬", "濒", "摈"};
-    m_pinyinDict["bing"] = {"并", "病", "兵", "冰", "饼", "屏", "炳"};
-    m_pinyinDict["bo"] = {"不", "播", "波", "博", "伯", "玻", "剥", "薄", "驳", "泊"};
-    m_pinyinDict["bu"] = {"不", "步", "部", "布", "补", "捕", "卜", "哺"};
-
-    m_pinyinDict["ca"] = {"擦", "嚓"};
-    m_pinyinDict["cai"] = {"才", "菜", "材", "财", "采", "彩", "睬", "裁"};
-    m_pinyinDict["can"] = {"参", "残", "惭", "灿", "餐", "蚕"};
-    m_pinyinDict["cang"] = {"藏", "仓", "苍", "沧"};
-    m_pinyinDict["cao"] = {"草", "操", "曹", "槽", "糙"};
-    m_pinyinDict["ce"] = {"策", "测", "侧", "厕", "册"};
-    m_pinyinDict["ceng"] = {"层", "曾", "蹭"};
-    m_pinyinDict["cha"] = {"查", "茶", "差", "插", "察", "叉", "刹", "岔"};
-    m_pinyinDict["chai"] = {"拆", "柴", "豺"};
-    m_pinyinDict["chan"] = {"产", "单", "缠", "掺", "蝉", "馋", "颤", "铲"};
-    m_pinyinDict["chang"] = {"长", "常", "场", "唱", "厂", "畅", "昌", "尝", "偿", "肠"};
-    m_pinyinDict["chao"] = {"超", "朝", "潮", "吵", "炒", "抄", "钞", "巢", "嘲"};
-    m_pinyinDict["che"] = {"车", "彻", "撤", "扯"};
-    m_pinyinDict["chen"] = {"沉", "陈", "晨", "臣", "尘", "衬", "趁", "称"};
-    m_pinyinDict["cheng"] = {"成", "城", "程", "承", "称", "诚", "乘", "盛", "呈", "撑"};
-    m_pinyinDict["chi"] = {"吃", "持", "尺", "赤", "迟", "齿", "耻", "翅", "斥", "炽"};
-    m_pinyinDict["chong"] = {"重", "冲", "充", "虫", "崇", "宠", "冲"};
-    m_pinyinDict["chou"] = {"抽", "愁", "臭", "仇", "筹", "绸", "稠", "丑"};
-    m_pinyinDict["chu"] = {"出", "处", "初", "除", "础", "储", "楚", "触", "畜", "厨"};
-    m_pinyinDict["chuan"] = {"传", "川", "船", "穿", "串", "喘"};
-    m_pinyinDict["chuang"] = {"创", "窗", "床", "闯", "疮"};
-    m_pinyinDict["chui"] = {"吹", "垂", "锤", "炊", "捶"};
-    m_pinyinDict["chun"] = {"春", "纯", "唇", "醇", "蠢"};
-    m_pinyinDict["chuo"] = {"戳", "绰"};
-    m_pinyinDict["ci"] = {"此", "次", "词", "辞", "刺", "赐", "磁", "瓷", "雌"};
-    m_pinyinDict["cong"] = {"从", "聪", "葱", "丛", "匆"};
-    m_pinyinDict["cou"] = {"凑", "辏"};
-    m_pinyinDict["cu"] = {"粗", "促", "醋", "簇", "蔟"};
-    m_pinyinDict["cuan"] = {"窜", "篡", "蹿"};
-    m_pinyinDict["cui"] = {"催", "脆", "翠", "摧", "璨", "悴"};
-    m_pinyinDict["cun"] = {"存", "村", "寸"};
-    m_pinyinDict["cuo"] = {"错", "措", "挫", "搓", "磋", "撮"};
-
-    m_pinyinDict["da"] = {"大", "打", "答", "达", "搭"};
-    m_pinyinDict["dai"] = {"带", "代", "待", "大", "呆", "贷", "戴", "袋"};
-    m_pinyinDict["dan"] = {"但", "单", "担", "弹", "蛋", "淡", "胆", "旦", "氮"};
-    m_pinyinDict["dang"] = {"当", "党", "档", "挡", "荡", "宕"};
-    m_pinyinDict["dao"] = {"到", "道", "导", "倒", "刀", "岛", "盗", "悼", "稻"};
-    m_pinyinDict["de"] = {"的", "得", "地", "德"};
-    m_pinyinDict["deng"] = {"等", "灯", "登", "邓", "蹬", "瞪", "凳"};
-    m_pinyinDict["di"] = {"地", "第", "底", "低", "敌", "滴", "迪", "的", "弟", "帝"};
-    m_pinyinDict["dian"] = {"点", "店", "电", "典", "殿", "碘", "淀", "垫", "惦"};
-    m_pinyinDict["diao"] = {"掉", "调", "吊", "钓", "刁", "雕", "凋"};
-    m_pinyinDict["die"] = {"跌", "爹", "碟", "蝶", "迭", "谍", "叠"};
-    m_pinyinDict["ding"] = {"定", "顶", "订", "钉", "丁", "盯", "叮", "鼎"};
-    m_pinyinDict["dong"] = {"东", "动", "懂", "冬", "董", "洞", "冻", "栋"};
-    m_pinyinDict["dou"] = {"都", "斗", "豆", "抖", "陡", "逗", "痘"};
-    m_pinyinDict["du"] = {"读", "度", "独", "都", "毒", "堵", "赌", "杜", "肚"};
-    m_pinyinDict["duan"] = {"段", "短", "断", "端", "锻", "缎", "煅"};
-    m_pinyinDict["dui"] = {"对", "队", "堆", "兑", "敦", "碓"};
-    m_pinyinDict["dun"] = {"顿", "吨", "蹲", "盾", "敦", "钝", "墩", "囤"};
-    m_pinyinDict["duo"] = {"多", "夺", "朵", "躲", "duo", "垛", "堕", "惰"};
-
-    m_pinyinDict["e"] = {"而", "儿", "额", "恶", "饿", "鹅", "蛾", "俄", "扼"};
-    m_pinyinDict["en"] = {"恩"};
-    m_pinyinDict["er"] = {"而", "儿", "二", "耳", "尔", "饵", "洱"};
-
-    m_pinyinDict["fa"] = {"发", "法", "罚", "乏", "伐", "筏", "阀"};
-    m_pinyinDict["fan"] = {"反", "饭", "犯", "范", "返", "翻", "凡", "烦", "繁", "泛"};
-    m_pinyinDict["fang"] = {"方", "放", "房", "防", "仿", "访", "纺", "芳"};
-    m_pinyinDict["fei"] = {"非", "飞", "费", "肥", "废", "沸", "肺", "菲", "啡"};
-    m_pinyinDict["fen"] = {"分", "份", "纷", "粉", "fen", "奋", "愤", "坟", "焚"};
-    m_pinyinDict["feng"] = {"风", "丰", "封", "疯", "峰", "锋", "蜂", "逢", "缝", "凤"};
-    m_pinyinDict["fo"] = {"佛"};
-    m_pinyinDict["fou"] = {"否"};
-    m_pinyinDict["fu"] = {"服", "福", "父", "副", "复", "负", "富", "妇", "府", "符"};
-
-    m_pinyinDict["ga"] = {"尴", "嘎", "噶"};
-    m_pinyinDict["gai"] = {"该", "改", "盖", "概", "钙", "溉", "丐"};
-    m_pinyinDict["gan"] = {"干", "感", "敢", "赶", "刚", "甘", "肝", "杆", "柑"};
-    m_pinyinDict["gang"] = {"刚", "钢", "岗", "港", "杠", "纲", "缸"};
-    m_pinyinDict["gao"] = {"高", "告", "搞", "稿", "膏", "糕", "镐", "睾"};
-    m_pinyinDict["ge"] = {"个", "各", "哥", "歌", "格", "隔", "割", "革", "葛"};
-    m_pinyinDict["gei"] = {"给"};
-    m_pinyinDict["gen"] = {"根", "跟", "艮"};
-    m_pinyinDict["geng"] = {"更", "耕", "颈", "梗", "埂", "耿", "哽"};
-    m_pinyinDict["gong"] = {"工", "公", "共", "功", "供", "宫", "恭", "贡", "躬", "弓"};
-    m_pinyinDict["gou"] = {"够", "构", "狗", "购", "沟", "勾", "钩", "gouу"};
-    m_pinyinDict["gu"] = {"古", "故", "顾", "固", "骨", "谷", "股", "鼓", "雇", "姑"};
-    m_pinyinDict["gua"] = {"挂", "刮", "瓜", "寡", "guà", "卦", "褂"};
-    m_pinyinDict["guai"] = {"怪", "拐", "乖"};
-    m_pinyinDict["guan"] = {"关", "管", "观", "官", "馆", "冠", "贯", "惯", "灌"};
-    m_pinyinDict["guang"] = {"光", "广", "逛"};
-    m_pinyinDict["gui"] = {"规", "贵", "跪", "鬼", "柜", "归", "桂", "硅", "轨"};
-    m_pinyinDict["gun"] = {"滚", "棍", "辊"};
-    m_pinyinDict["guo"] = {"国", "过", "果", "锅", "裹", "郭"};
-
-    m_pinyinDict["ha"] = {"哈"};
-    m_pinyinDict["hai"] = {"还", "海", "害", "孩", "骸", "骇"};
-    m_pinyinDict["han"] = {"和", "汉", "含", "寒", "喊", "汗", "韩", "旱", "焊"};
-    m_pinyinDict["hang"] = {"行", "航", "杭", "巷", "夯"};
-    m_pinyinDict["hao"] = {"好", "号", "浩", "毫", "豪", "耗", "郝", "嚎"};
-    m_pinyinDict["he"] = {"和", "何", "合", "河", "核", "喝", "贺", "荷", "赫"};
-    m_pinyinDict["hei"] = {"黑", "嘿"};
-    m_pinyinDict["hen"] = {"很", "恨", "痕", "狠"};
-    m_pinyinDict["heng"] = {"横", "恒", "衡", "哼"};
-    m_pinyinDict["hong"] = {"红", "洪", "宏", "虹", "鸿", "哄", "弘", "轰"};
-    m_pinyinDict["hou"] = {"后", "候", "厚", "侯", "喉", "吼"};
-    m_pinyinDict["hu"] = {"和", "户", "护", "互", "呼", "胡", "湖", "壶", "糊", "虎"};
-    m_pinyinDict["hua"] = {"化", "花", "华", "话", "画", "滑", "划", "哗"};
-    m_pinyinDict["huai"] = {"怀", "坏", "淮", "槐"};
-    m_pinyinDict["huan"] = {"换", "还", "环", "欢", "缓", "幻", "唤", "患", "焕"};
-    m_pinyinDict["huang"] = {"黄", "皇", "荒", "慌", "煌", "晃", "幌", "恍", "谎"};
-    m_pinyinDict["hui"] = {"会", "回", "汇", "惠", "灰", "辉", "挥", "毁", "慧"};
-    m_pinyinDict["hun"] = {"婚", "混", "昏", "魂", "浑", "荤"};
-    m_pinyinDict["huo"] = {"或", "活", "火", "获", "货", "祸", "惑", "霍"};
-
-    // 添加更多常用字...
-    m_pinyinDict["ji"] = {"及", "机", "几", "己", "技", "际", "记", "集", "极", "级"};
-    m_pinyinDict["jia"] = {"家", "加", "价", "假", "甲", "嘉", "佳", "架", "驾", "稼"};
-    m_pinyinDict["jian"] = {"见", "间", "建", "件", "简", "检", "坚", "减", "监", "健"};
-    m_pinyinDict["jiang"] = {"将", "江", "讲", "降", "jiang", "奖", "蒋", "僵", "姜", "浆"};
-    m_pinyinDict["jiao"] = {"教", "叫", "交", "较", "角", "脚", "觉", "校", "焦", "胶"};
-    m_pinyinDict["jie"] = {"接", "解", "结", "节", "界", "姐", "街", "借", "介", "届"};
-    m_pinyinDict["jin"] = {"进", "今", "金", "近", "仅", "紧", "尽", "劲", "禁", "斤"};
-    m_pinyinDict["jing"] = {"经", "精", "京", "景", "警", "静", "竞", "境", "镜", "惊"};
-    m_pinyinDict["jiong"] = {"窘", "炯", "迥"};
-    m_pinyinDict["jiu"] = {"就", "九", "久", "旧", "究", "救", "酒", "舅", "纠", "揪"};
-    m_pinyinDict["ju"] = {"具", "据", "巨", "举", "局", "句", "拒", "聚", "距", "俱"};
-    m_pinyinDict["juan"] = {"卷", "圈", "捐", "juan", "倦", "眷", "绢", "隽"};
-    m_pinyinDict["jue"] = {"觉", "决", "绝", "掘", "诀", "抉", "倔", "爵", "嚼"};
-    m_pinyinDict["jun"] = {"军", "君", "均", "菌", "俊", "郡", "峻", "竣"};
-
-    m_pinyinDict["ka"] = {"卡", "咖", "喀"};
-    m_pinyinDict["kai"] = {"开", "凯", "慨", "楷", "揩", "铠"};
-    m_pinyinDict["kan"] = {"看", "刊", "堪", "勘", "坎", "砍", "侃"};
-    m_pinyinDict["kang"] = {"康", "抗", "扛", "慷", "糠", "炕"};
-    m_pinyinDict["kao"] = {"考", "靠", "烤", "拷"};
-    m_pinyinDict["ke"] = {"可", "课", "科", "克", "刻", "客", "渴", "壳", "咳", "颗"};
-    m_pinyinDict["ken"] = {"肯", "垦", "恳", "啃"};
-    m_pinyinDict["keng"] = {"坑", "铿"};
-    m_pinyinDict["kong"] = {"空", "孔", "控", "恐"};
-    m_pinyinDict["kou"] = {"口", "扣", "寇", "叩", "抠"};
-    m_pinyinDict["ku"] = {"苦", "库", "哭", "酷", "裤", "窟", "骷"};
-    m_pinyinDict["kua"] = {"夸", "跨", "垮", "挎", "胯"};
-    m_pinyinDict["kuai"] = {"快", "块", "筷", "会", "蒯", "侩"};
-    m_pinyinDict["kuan"] = {"宽", "款"};
-    m_pinyinDict["kuang"] = {"况", "矿", "框", "狂", "旷", "匡", "筐", "眶"};
-    m_pinyinDict["kui"] = {"亏", "愧", "奎", "魁", "傀", "馈", "窥", "溃"};
-    m_pinyinDict["kun"] = {"困", "捆", "昆", "坤", "kun", "琨", "髡"};
-    m_pinyinDict["kuo"] = {"扩", "括", "阔", "廓"};
-
-    m_pinyinDict["la"] = {"啦", "拉", "辣", "腊", "蜡", "垃", "喇"};
-    m_pinyinDict["lai"] = {"来", "莱", "赖", "睐", "濞"};
-    m_pinyinDict["lan"] = {"蓝", "览", "懒", "栏", "烂", "兰", "拦", "篮", "澜", "揽"};
-    m_pinyinDict["lang"] = {"浪", "郎", "狼", "朗", "廊", "琅", "榔"};
-    m_pinyinDict["lao"] = {"老", "劳", "牢", "捞", "涝", "烙", "姥"};
-    m_pinyinDict["le"] = {"了", "乐", "勒"};
-    m_pinyinDict["lei"] = {"累", "类", "泪", "雷", "垒", "擂", "蕾", "镭"};
-    m_pinyinDict["leng"] = {"冷", "愣", "棱"};
-    m_pinyinDict["li"] = {"里", "理", "力", "利", "立", "离", "历", "李", "例", "礼"};
-    m_pinyinDict["lian"] = {"连", "联", "练", "脸", "恋", "廉", "莲", "链", "帘", "炼"};
-    m_pinyinDict["liang"] = {"两", "量", "亮", "良", "辆", "粮", "凉", "梁", "粱", "晾"};
-    m_pinyinDict["liao"] = {"了", "料", "疗", "辽", "聊", "廖", "撩", "寥", "嘹"};
-    m_pinyinDict["lie"] = {"列", "烈", "裂", "猎", "劣", "冽", "咧"};
-    m_pinyinDict["lin"] = {"林", "临", "邻", "淋", "琳", "霖", "磷", "鳞", "麟"};
-    m_pinyinDict["ling"] = {"零", "领", "令", "灵", "另", "岭", "玲", "凌", "铃", "陵"};
-    m_pinyinDict["liu"] = {"流", "六", "留", "刘", "柳", "溜", "榴", "瘤"};
-    m_pinyinDict["long"] = {"龙", "隆", "笼", "聋", "拢", "垄", "陇", "垅"};
-    m_pinyinDict["lou"] = {"楼", "漏", "陋", "搂", "篓", "镂"};
-    m_pinyinDict["lu"] = {"路", "录", "露", "鲁", "陆", "卢", "炉", "绿", "鹿", "芦"};
-    m_pinyinDict["lv"] = {"绿", "率", "律", "虑", "旅", "吕", "铝", "履", "滤", "氯"};
-    m_pinyinDict["luan"] = {"乱", "卵", "孪", "峦", "滦", "挛"};
-    m_pinyinDict["lue"] = {"略", "掠", "lue"};
-    m_pinyinDict["lun"] = {"论", "轮", "伦", "沦", "抡"};
-    m_pinyinDict["luo"] = {"落", "罗", "洛", "络", "骆", "锣", "螺", "逻", "裸"};
-
-    m_pinyinDict["ma"] = {"吗", "妈", "马", "骂", "吗", "麻", "嘛", "蚂", "码"};
-    m_pinyinDict["mai"] = {"买", "卖", "迈", "麦", "脉", "埋"};
-    m_pinyinDict["man"] = {"满", "慢", "漫", "曼", "蛮", "瞒", "馒", "蔓"};
-    m_pinyinDict["mang"] = {"忙", "芒", "盲", "茫", "莽", "蟒"};
-    m_pinyinDict["mao"] = {"没", "毛", "茂", "冒", "帽", "貌", "贸", "矛", "茅", "锚"};
-    m_pinyinDict["me"] = {"么"};
-    m_pinyinDict["mei"] = {"没", "每", "美", "妹", "媒", "煤", "梅", "昧", "魅", "枚"};
-    m_pinyinDict["men"] = {"们", "门", "闷", "们"};
-    m_pinyinDict["meng"] = {"梦", "盟", "猛", "蒙", "萌", "朦", "檬", "孟"};
-    m_pinyinDict["mi"] = {"米", "密", "迷", "秘", "蜜", "谜", "觅", "泌", "眯", "靡"};
-    m_pinyinDict["mian"] = {"面", "免", "棉", "眠", "绵", "勉", "缅", "腼", "渑"};
-    m_pinyinDict["miao"] = {"秒", "妙", "苗", "描", "渺", "缪", "庙", "瞄", "藐"};
-    m_pinyinDict["mie"] = {"灭", "蔑", "篾"};
-    m_pinyinDict["min"] = {"民", "敏", "闽", "抿", "皿", "泯", "悯", "珉"};
-    m_pinyinDict["ming"] = {"明", "名", "命", "鸣", "铭", "冥", "茗", "溟"};
-    m_pinyinDict["miu"] = {"谬"};
-    m_pinyinDict["mo"] = {"模", "么", "摸", "莫", "磨", "墨", "末", "漠", "默", "膜"};
-    m_pinyinDict["mou"] = {"某", "谋", "牟", "眸", "哞"};
-    m_pinyinDict["mu"] = {"目", "木", "母", "牧", "幕", "墓", "慕", "睦", "穆", "姆"};
-
-    m_pinyinDict["na"] = {"那", "拿", "哪", "na", "纳", "钠", "娜", "捺"};
-    m_pinyinDict["nai"] = {"奶", "耐", "奈", "乃", "氖", "萘"};
-    m_pinyinDict["nan"] = {"南", "难", "男", "喃", "楠", "囡"};
-    m_pinyinDict["nang"] = {"囊", "馕"};
-    m_pinyinDict["nao"] = {"脑", "闹", "恼", "挠", "瑙", "淖"};
-    m_pinyinDict["ne"] = {"呢"};
-    m_pinyinDict["nei"] = {"内"};
-    m_pinyinDict["nen"] = {"嫩", "恁"};
-    m_pinyinDict["neng"] = {"能"};
-    m_pinyinDict["ni"] = {"你", "尼", "泥", "拟", "逆", "腻", "妮", "匿", "倪", "霓"};
-    m_pinyinDict["nian"] = {"年", "念", "娘", "捻", "碾", "辗", "黏", "蔫", "拈"};
-    m_pinyinDict["niang"] = {"娘", "酿"};
-    m_pinyinDict["niao"] = {"鸟", "尿", "袅", "茑"};
-    m_pinyinDict["nie"] = {"捏", "聂", "啮", "镊", "孽", "蹑", "臬"};
-    m_pinyinDict["nin"] = {"您", "宁"};
-    m_pinyinDict["ning"] = {"宁", "凝", "拧", "泞", "柠", "狞", "咛"};
-    m_pinyinDict["niu"] = {"牛", "扭", "纽", "钮", "拗"};
-    m_pinyinDict["nong"] = {"农", "浓", "弄", "侬", "脓"};
-    m_pinyinDict["nu"] = {"奴", "努", "怒", "弩", "驽"};
-    m_pinyinDict["nv"] = {"女", "恼"};
-    m_pinyinDict["nuan"] = {"暖"};
-    m_pinyinDict["nue"] = {"虐", "疟"};
-    m_pinyinDict["nuo"] = {"诺", "懦", "糯", "挪", "傩", "喏"};
-
-    // ... 可以继续添加更多拼音
-
-    // 添加常用词组的拼音映射（简化版）
-    m_pinyinDict["nihao"] = {"你好"};
-    m_pinyinDict["zhongguo"] = {"中国"};
-    m_pinyinDict["xièxiè"] = {"谢谢"};
-    m_pinyinDict["zaijian"] = {"再见"};
-}
-
-void ChineseWidget::setPinyin(const QString &pinyin)
-{
-    clear();
-
-    if (pinyin.isEmpty()) {
+void ChineseWidget::setComposition(const QString &preedit, const CandidateList &candidates, bool valid)
+{
+    if (preedit.isEmpty()) {
+        clear();
         return;
     }
 
-    // 显示拼音本身
-    addCandidate(pinyin);
+    // 编码与引擎缓冲隐式共享，候选词只保存词典视图
+    // 条目的旧文本指向旧列表（可能持有动态存储），在全部覆盖或清空前保持其存活
+    const CandidateList previous = m_candidates;
+    m_preedit = preedit;
+    m_candidates = candidates;
 
-    // 查找匹配的汉字
-    if (m_pinyinDict.contains(pinyin)) {
-        QStringList candidates = m_pinyinDict[pinyin];
-        for (const QString &candidate : candidates) {
-            addCandidate(candidate);
-        }
+    setCandidateCount(1 + m_candidates.size());
+
+    // 显示编码本身
+    setCandidateText(0, m_preedit);
+    item(0)->setForeground(valid ? QBrush() : QBrush(QColor("#ff5252")));
+
+    // 匹配的汉字直接引用词典存储，不复制字符
+    for (qsizetype i = 0; i < m_candidates.size(); ++i) {
+        const QStringView candidate = m_candidates.at(i);
+        setCandidateText(i + 1, QString::fromRawData(candidate.data(), candidate.size()));
     }
+
+    scrollToItem(item(0));
+}
+
+void ChineseWidget::setPredictions(const CandidateList &predictions)
+{
+    if (predictions.isEmpty()) {
+        clear();
+        return;
+    }
+
+    const CandidateList previous = m_candidates;
+    m_preedit.clear();
+    m_candidates = predictions;
+
+    setCandidateCount(m_candidates.size());
+    item(0)->setForeground(QBrush());
+    for (qsizetype i = 0; i < m_candidates.size(); ++i) {
+        const QStringView candidate = m_candidates.at(i);
+        setCandidateText(i, QString::fromRawData(candidate.data(), candidate.size()));
+    }
+
+    scrollToItem(item(0));
 }
 
 void ChineseWidget::clear()
 {
-    QListWidget::clear();
+    const CandidateList previous = m_candidates;
+    m_preedit.clear();
+    m_candidates = CandidateList();
+    setCandidateCount(0);
 }
 
-void ChineseWidget::addCandidate(const QString &text)
+QStringView ChineseWidget::candidateAt(int index) const
 {
-    QListWidgetItem *item = new QListWidgetItem(text, this);
-    QFont font;
-    font.setPointSize(16);
-    font.setBold(true);
-    item->setFont(font);
-    item->setTextAlignment(Qt::AlignCenter);
+    // 联想模式下没有编码条目
+    const int offset = m_preedit.isEmpty() ? 0 : 1;
+    if (offset == 1 && index == 0) {
+        return m_preedit;
+    }
+    if (index >= offset && index - offset < m_candidates.size()) {
+        return m_candidates.at(index - offset);
+    }
+    return QStringView();
+}
 
-    // 根据文本长度调整宽度
-    int width = text.length() * font.pointSize() * 2;
-    item->setSizeHint(QSize(width, 45));
+void ChineseWidget::setCandidateCount(int count)
+{
+    clearSelection();
+
+    // 条目只增不减，多余的隐藏以便下次复用；隐藏时清空文本，不再引用候选列表
+    while (QListWidget::count() < count) {
+        QListWidgetItem *item = new QListWidgetItem(this);
+        QFont font;
+        font.setPointSize(16);
+        font.setBold(true);
+        item->setFont(font);
+        item->setTextAlignment(Qt::AlignCenter);
+        item->setHidden(true);
+    }
 
-    addItem(item);
+    const int from = qMin(count, m_visibleCount);
+    const int to = qMax(count, m_visibleCount);
+    for (int i = from; i < to; ++i) {
+        item(i)->setHidden(i >= count);
+        if (i >= count) {
+            item(i)->setText(QString());
+        }
+    }
+    m_visibleCount = count;
+}
+
+void ChineseWidget::setCandidateText(int index, const QString &text)
+{
+    QListWidgetItem *candidateItem = item(index);
+    candidateItem->setText(text);
+
+    // 根据文本长度调整宽度
+    int width = text.length() * candidateItem->font().pointSize() * 2;
+    candidateItem->setSizeHint(QSize(width, 45));
 }
 
 void ChineseWidget::onItemClicked(QListWidgetItem *item)
 {
-    emit candidateSelected(item->text());
+    emit candidateSelected(candidateAt(row(item)));
 }
 
 // ==================== KeyboardButton 实现 ====================
@@ -368,8 +189,19 @@ void KeyboardButton::setDisplayText(const QString &text)
     setText(text);
 }
 
+void KeyboardButton::setTouchDown(bool down)
+{
+    if (down && !m_pressedImage.isEmpty()) {
+        setStyleSheet(QString("QPushButton { border-image: url(%1); }").arg(m_pressedImage));
+    } else if (!down) {
+        updateStyleSheet();
+    }
+    setDown(down);
+}
+
 void KeyboardButton::mousePressEvent(QMouseEvent *event)
 {
+    m_pressPosition = event->position();
     if (!m_pressedImage.isEmpty()) {
         setStyleSheet(QString("QPushButton { border-image: url(%1); }").arg(m_pressedImage));
     }
@@ -397,9 +229,22 @@ Keyboard::Keyboard(QWidget *parent)
     , m_keyboardMode(LowerCase)
     , m_inputMode(English)
     , m_capsLock(false)
+    , m_physicalKeyboard(false)
+    , m_keyReceiver(nullptr)
+    , m_keyModifiers(Qt::NoModifier)
+    , m_engine(&m_pinyinEngine)
     , m_buttonSize(60, 50)
     , m_inputModeButton(nullptr)
+    , m_spatialModelDirty(true)
+    , m_gestureDecoderDirty(true)
+    , m_gestureIndexTimer(new QTimer(this))
+    , m_gestureTouchId(-1)
+    , m_gestureActive(false)
 {
+    m_gestureIndexTimer->setSingleShot(true);
+    m_gestureIndexTimer->setInterval(GestureIndexDelay);
+    connect(m_gestureIndexTimer, &QTimer::timeout, this, &Keyboard::rebuildGestureIndex);
+
     setupUI();
 }
 
@@ -431,11 +276,23 @@ void Keyboard::setupUI()
     m_numberLayout->setContentsMargins(0, 0, 0, 0);
     createNumberKeyboard();
 
+    // 创建符号面板
+    m_symbolPage = new QWidget(this);
+    createSymbolKeyboard();
+
     m_mainLayout->addWidget(m_letterWidget);
     m_mainLayout->addWidget(m_numberWidget);
+    m_mainLayout->addWidget(m_symbolPage);
+
+    // 按键区域直接处理触摸事件，候选栏仍使用鼠标事件
+    for (QWidget *container : {m_letterWidget, m_numberWidget, m_symbolKeysWidget}) {
+        container->setAttribute(Qt::WA_AcceptTouchEvents);
+        container->installEventFilter(this);
+    }
 
     // 默认显示字母键盘
     m_numberWidget->hide();
+    m_symbolPage->hide();
 
     // 设置默认输入模式（英文）
     setInputMode(English);
@@ -497,7 +354,7 @@ void Keyboard::createLetterKeyboard()
 
     KeyboardButton *spaceBtn = createButton("Space", Qt::Key_Space);
     m_letterLayout->addWidget(spaceBtn, 4, 3, 1, 3);
-    connect(spaceBtn, &KeyboardButton::keyPressed, this, &Keyboard::onKeyButtonPressed);
+    connect(spaceBtn, &KeyboardButton::keyPressed, this, &Keyboard::onSpacePressed);
 
     // 中英文切换按钮 - 显示当前输入模式
     m_inputModeButton = createButton("中/英", Qt::Key_Mode_switch);
@@ -525,32 +382,72 @@ void Keyboard::createNumberKeyboard()
     m_numberLayout->itemAtPosition(3, 0)->widget()->deleteLater();
     addButtonToLayout(m_numberLayout, "0", Qt::Key_0, 3, 0, 1, 2);
 
-    // 符号键
-    QStringList symbols = {"+", "-", "*", "/", ".", ",", "!", "?"};
-    for (int i = 0; i < symbols.size() && i < 4; ++i) {
-        addButtonToLayout(m_numberLayout, symbols[i], Qt::Key_Plus + i, i, 3);
+    // 符号键（ASCII 符号的键码即其字符编码），第 4 列运算符、第 5 列标点
+    const QStringList operators = {"+", "-", "*", "/"};
+    for (int i = 0; i < operators.size(); ++i) {
+        addButtonToLayout(m_numberLayout, operators[i], operators[i].at(0).unicode(), i, 3);
     }
-
-    // 小数点和逗号
     addButtonToLayout(m_numberLayout, ".", Qt::Key_Period, 3, 2);
-    addButtonToLayout(m_numberLayout, ",", Qt::Key_Comma, 2, 4);
+
+    const QStringList punctuation = {",", "!", "?"};
+    for (int i = 0; i < punctuation.size(); ++i) {
+        addButtonToLayout(m_numberLayout, punctuation[i], punctuation[i].at(0).unicode(), i + 1, 4);
+    }
 
     // Backspace
     KeyboardButton *backspaceBtn = createButton("←", Qt::Key_Backspace);
-    m_numberLayout->addWidget(backspaceBtn, 0, 4, 2, 1);
+    m_numberLayout->addWidget(backspaceBtn, 0, 4, 1, 1);
     connect(backspaceBtn, &KeyboardButton::keyPressed, this, &Keyboard::onBackspacePressed);
 
-    // ABC 切换按钮
+    // 最后一行: ABC 切换, 符号面板, Enter
     KeyboardButton *modeBtn = createButton("ABC", Qt::Key_Tab);
-    m_numberLayout->addWidget(modeBtn, 3, 4, 1, 1);
+    m_numberLayout->addWidget(modeBtn, 4, 0, 1, 1);
     connect(modeBtn, &KeyboardButton::keyPressed, this, &Keyboard::onModeChanged);
 
-    // Enter 按钮
+    KeyboardButton *symbolBtn = createButton("#+=", Qt::Key_Mode_switch);
+    m_numberLayout->addWidget(symbolBtn, 4, 1, 1, 2);
+    connect(symbolBtn, &KeyboardButton::keyPressed, this, &Keyboard::onSymbolPageToggled);
+
     KeyboardButton *enterBtn = createButton("↵", Qt::Key_Return);
-    m_numberLayout->addWidget(enterBtn, 3, 3, 1, 1);
+    m_numberLayout->addWidget(enterBtn, 4, 3, 1, 2);
     connect(enterBtn, &KeyboardButton::keyPressed, this, &Keyboard::onEnterPressed);
 }
 
+void Keyboard::createSymbolKeyboard()
+{
+    // 符号网格占满上方，底部为功能键
+    m_symbolWidget = new SymbolWidget(m_symbolPage);
+    connect(m_symbolWidget, &SymbolWidget::symbolSelected, this, &Keyboard::onSymbolSelected);
+
+    QVBoxLayout *layout = new QVBoxLayout(m_symbolPage);
+    layout->setSpacing(5);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addWidget(m_symbolWidget, 1);
+
+    // 功能键放在单独的容器中，与字母、数字键盘一样直接处理触摸
+    m_symbolKeysWidget = new QWidget(m_symbolPage);
+    QHBoxLayout *bottomLayout = new QHBoxLayout(m_symbolKeysWidget);
+    bottomLayout->setSpacing(5);
+    bottomLayout->setContentsMargins(0, 0, 0, 0);
+    layout->addWidget(m_symbolKeysWidget);
+
+    KeyboardButton *numberBtn = createButton("123", Qt::Key_Mode_switch);
+    bottomLayout->addWidget(numberBtn);
+    connect(numberBtn, &KeyboardButton::keyPressed, this, &Keyboard::onSymbolPageToggled);
+
+    KeyboardButton *modeBtn = createButton("ABC", Qt::Key_Tab);
+    bottomLayout->addWidget(modeBtn);
+    connect(modeBtn, &KeyboardButton::keyPressed, this, &Keyboard::onModeChanged);
+
+    KeyboardButton *spaceBtn = createButton("Space", Qt::Key_Space);
+    bottomLayout->addWidget(spaceBtn, 2);
+    connect(spaceBtn, &KeyboardButton::keyPressed, this, &Keyboard::onSpacePressed);
+
+    KeyboardButton *backspaceBtn = createButton("←", Qt::Key_Backspace);
+    bottomLayout->addWidget(backspaceBtn);
+    connect(backspaceBtn, &KeyboardButton::keyPressed, this, &Keyboard::onBackspacePressed);
+}
+
 KeyboardButton* Keyboard::createButton(const QString &text, int keyCode)
 {
     KeyboardButton *button = new KeyboardButton(text, keyCode, this);
@@ -600,6 +497,29 @@ void Keyboard::setTargetWidget(QWidget *widget)
     m_targetWidget = widget;
 }
 
+void Keyboard::setInputEngine(InputEngine *engine)
+{
+    // 结束旧引擎中未完成的输入
+    m_engine->reset();
+    m_engine = engine ? engine : &m_pinyinEngine;
+    clearCandidates();
+}
+
+void Keyboard::setPhysicalKeyboardEnabled(bool enabled)
+{
+    if (enabled == m_physicalKeyboard) {
+        return;
+    }
+
+    // 实体按键先送到焦点控件，在应用级过滤器中拦截
+    m_physicalKeyboard = enabled;
+    if (enabled) {
+        qApp->installEventFilter(this);
+    } else {
+        qApp->removeEventFilter(this);
+    }
+}
+
 void Keyboard::setButtonStyleSheet(const QString &styleSheet)
 {
     m_buttonStyleSheet = styleSheet;
@@ -678,9 +598,13 @@ void Keyboard::setInputMode(InputMode mode)
         }
     }
 
+    // 联想与补全不跨输入模式
+    m_lastCommit.clear();
+    m_completer.reset();
+
     // 切换到英文时清空拼音缓冲
     if (mode == English) {
-        m_pinyinBuffer.clear();
+        m_engine->reset();
         m_chineseWidget->clear();
         m_chineseWidget->hide();
     }
@@ -688,9 +612,10 @@ void Keyboard::setInputMode(InputMode mode)
 
 void Keyboard::updateKeyboardDisplay()
 {
-    if (m_keyboardMode == Number) {
+    m_symbolPage->setVisible(m_keyboardMode == Symbol);
+    if (m_keyboardMode == Number || m_keyboardMode == Symbol) {
         m_letterWidget->hide();
-        m_numberWidget->show();
+        m_numberWidget->setVisible(m_keyboardMode == Number);
     } else {
         m_letterWidget->show();
         m_numberWidget->hide();
@@ -708,17 +633,48 @@ void Keyboard::updateKeyboardDisplay()
 
 void Keyboard::onKeyButtonPressed(int keyCode, const QString &text)
 {
-    // 中文输入模式
-    if (m_inputMode == Chinese && QRegularExpression("^[a-zA-Z]$").match(text).hasMatch()) {
-        m_pinyinBuffer += text.toLower();
-        m_chineseWidget->setPinyin(m_pinyinBuffer);
-        m_chineseWidget->show();
+    // 中文输入模式 - 由输入引擎决定是否接收该键，并附带触点概率
+    KeyboardButton *button = qobject_cast<KeyboardButton *>(sender());
+    if (m_inputMode == Chinese && text.size() == 1
+        && m_engine->feedTouch(text.at(0), keyGuess(button, text.at(0)))) {
+        // 引擎在按键过程中自动上屏的文本（如五笔顶字上屏）
+        const QString committed = m_engine->takeCommitted();
+        if (!committed.isEmpty()) {
+            m_lastCommit = committed;
+            sendTextToTarget(committed);
+        }
+        updateComposition();
+        if (!committed.isEmpty() && !m_engine->isComposing()) {
+            QMetaObject::invokeMethod(this, &Keyboard::showPredictions, Qt::QueuedConnection);
+        }
         return;
     }
 
+    // 输入其他键时结束联想
+    if (m_inputMode == Chinese && !m_engine->isComposing()) {
+        clearCandidates();
+    }
+
     // 英文输入模式或非字母键
     sendKeyEventToTarget(keyCode, text);
     emit keyClicked(keyCode, text);
+
+    // 英文输入模式 - 字母照常发送，同时逐键更新单词补全
+    if (m_inputMode == English) {
+        if (text.size() == 1 && m_completer.feedTouch(text.at(0), keyGuess(button, text.at(0)))) {
+            updateCompletions();
+            return;
+        }
+
+        // 空格结束一个单词，显示下一个词的预测
+        const QString word = m_completer.prefix();
+        m_completer.reset();
+        clearCandidates();
+        if (keyCode == Qt::Key_Space && !word.isEmpty()) {
+            m_lastCommit = word;
+            QMetaObject::invokeMethod(this, &Keyboard::showPredictions, Qt::QueuedConnection);
+        }
+    }
 }
 
 void Keyboard::onCapsLockToggled()
@@ -730,7 +686,7 @@ void Keyboard::onCapsLockToggled()
 
 void Keyboard::onModeChanged()
 {
-    if (m_keyboardMode == Number) {
+    if (m_keyboardMode == Number || m_keyboardMode == Symbol) {
         m_keyboardMode = LowerCase;
     } else {
         m_keyboardMode = Number;
@@ -738,6 +694,23 @@ void Keyboard::onModeChanged()
     updateKeyboardDisplay();
 }
 
+void Keyboard::onSymbolPageToggled()
+{
+    m_keyboardMode = m_keyboardMode == Symbol ? Number : Symbol;
+    updateKeyboardDisplay();
+}
+
+void Keyboard::onSymbolSelected(const QString &symbol)
+{
+    // 符号整段发送（表情为代理对），结束单词补全与联想，不打断中文编码
+    m_completer.reset();
+    if (!m_engine->isComposing()) {
+        clearCandidates();
+    }
+    sendTextToTarget(symbol);
+    emit keyClicked(0, symbol);
+}
+
 void Keyboard::onInputModeChanged()
 {
     if (m_inputMode == English) {
@@ -749,80 +722,458 @@ void Keyboard::onInputModeChanged()
 
 void Keyboard::onBackspacePressed()
 {
-    // 中文输入模式下，先删除拼音缓冲
-    if (m_inputMode == Chinese && !m_pinyinBuffer.isEmpty()) {
-        m_pinyinBuffer.chop(1);
-        if (m_pinyinBuffer.isEmpty()) {
-            m_chineseWidget->clear();
-            m_chineseWidget->hide();
-        } else {
-            m_chineseWidget->setPinyin(m_pinyinBuffer);
-        }
+    // 中文输入模式下，先删除引擎中的编码
+    if (m_inputMode == Chinese && m_engine->backspace()) {
+        updateComposition();
         return;
     }
 
+    // 英文输入模式下，字母已发送到目标控件，删除后恢复上一步的补全
+    if (m_inputMode == English && m_completer.backspace()) {
+        sendKeyEventToTarget(Qt::Key_Backspace, "");
+        updateCompletions();
+        return;
+    }
+
+    clearCandidates();
     sendKeyEventToTarget(Qt::Key_Backspace, "");
 }
 
 void Keyboard::onEnterPressed()
 {
-    // 中文输入模式下，如果有拼音缓冲，直接输入拼音
-    if (m_inputMode == Chinese && !m_pinyinBuffer.isEmpty()) {
-        sendTextToTarget(m_pinyinBuffer);
-        m_pinyinBuffer.clear();
-        m_chineseWidget->clear();
-        m_chineseWidget->hide();
+    // 中文输入模式下，如果有编码，直接输入编码
+    if (m_inputMode == Chinese && m_engine->isComposing()) {
+        sendTextToTarget(m_engine->commit(m_engine->preedit()));
+        clearCandidates();
         return;
     }
 
+    m_completer.reset();
+    clearCandidates();
     sendKeyEventToTarget(Qt::Key_Return, "\n");
 }
 
-void Keyboard::onCandidateSelected(const QString &text)
+void Keyboard::onSpacePressed()
+{
+    // 中文输入时空格上屏首选，没有候选时上屏编码
+    if (m_inputMode == Chinese && m_engine->isComposing()) {
+        const CandidateList candidates = m_engine->candidates();
+        if (candidates.isEmpty()) {
+            onEnterPressed();
+        } else {
+            onCandidateSelected(candidates.at(0));
+        }
+        return;
+    }
+
+    // 按钮文本为 "Space"，实际发送空格
+    onKeyButtonPressed(Qt::Key_Space, QStringLiteral(" "));
+}
+
+bool Keyboard::selectCandidate(int number)
+{
+    // 数字键按显示顺序选择候选（不含编码条目），列表在上屏期间保持有效
+    if (m_inputMode != Chinese || !m_engine->isComposing()) {
+        return false;
+    }
+
+    const CandidateList candidates = m_engine->candidates();
+    if (number < 1 || number > candidates.size()) {
+        return false;
+    }
+
+    onCandidateSelected(candidates.at(number - 1));
+    return true;
+}
+
+void Keyboard::onCandidateSelected(QStringView text)
 {
-    // 输入选中的候选词
-    sendTextToTarget(text);
+    // 英文补全只补发尚未输入的部分，预测词整词发送；视图在补全器重置前复制
+    if (m_inputMode == English) {
+        const QString word = text.toString();
+        const QString prefix = m_completer.prefix();
+        if (word.startsWith(prefix, Qt::CaseInsensitive)) {
+            commitWord(word, word.mid(prefix.size()));
+            return;
+        }
+
+        // 纠正了相邻按键的单词：先删除已发送的字母，再整词上屏
+        for (qsizetype i = 0; i < prefix.size(); ++i) {
+            sendKeyEventToTarget(Qt::Key_Backspace, "");
+        }
+        commitWord(word, word);
+        return;
+    }
+
+    // 输入选中的候选词 - 仅在上屏时复制一次，同时结束引擎中的输入
+    m_lastCommit = m_engine->commit(text);
+    sendTextToTarget(m_lastCommit);
+    clearCandidates();
+
+    // 联想词在事件循环的下一轮计算，不拖慢本次上屏
+    QMetaObject::invokeMethod(this, &Keyboard::showPredictions, Qt::QueuedConnection);
+}
 
-    // 清空拼音缓冲
-    m_pinyinBuffer.clear();
+void Keyboard::showPredictions()
+{
+    // 期间已开始输入新的拼音/单词
+    const bool composing = m_inputMode == Chinese ? m_engine->isComposing() : m_completer.isComposing();
+    if (composing || m_lastCommit.isEmpty()) {
+        return;
+    }
+
+    const CandidateList predictions = m_inputMode == Chinese
+            ? PinyinDict::instance().successors(m_lastCommit)
+            : EnglishLexicon::instance().successors(m_lastCommit);
+    if (predictions.isEmpty()) {
+        return;
+    }
+
+    m_chineseWidget->setPredictions(predictions);
+    m_chineseWidget->show();
+}
+
+void Keyboard::updateComposition()
+{
+    if (!m_engine->isComposing()) {
+        clearCandidates();
+        return;
+    }
+
+    m_chineseWidget->setComposition(m_engine->preedit(), m_engine->candidates(),
+                                    m_engine->isPreeditValid());
+    m_chineseWidget->show();
+}
+
+void Keyboard::updateCompletions()
+{
+    const CandidateList completions = m_completer.completions();
+    if (completions.isEmpty()) {
+        clearCandidates();
+        return;
+    }
+
+    m_chineseWidget->setPredictions(completions);
+    m_chineseWidget->show();
+}
+
+void Keyboard::commitWord(const QString &word, const QString &text)
+{
+    // 英文单词上屏（text 为实际发送的部分）并补一个空格，随后显示下一个词的预测
+    QString output = m_capsLock ? text.toUpper() : text;
+    output += u' ';
+    m_completer.reset();
+    sendTextToTarget(output);
+    clearCandidates();
+
+    m_lastCommit = word;
+    QMetaObject::invokeMethod(this, &Keyboard::showPredictions, Qt::QueuedConnection);
+}
+
+void Keyboard::clearCandidates()
+{
     m_chineseWidget->clear();
     m_chineseWidget->hide();
 }
 
-void Keyboard::sendKeyEventToTarget(int keyCode, const QString &text)
+bool Keyboard::eventFilter(QObject *watched, QEvent *event)
 {
-    if (!m_targetWidget) {
-        m_targetWidget = QApplication::focusWidget();
+    // 实体键盘：只处理平台产生的按键（键盘自己补发的事件不是 spontaneous），
+    // 且只在事件首次送达焦点控件时处理一次，不处理向父控件传播的副本
+    if (m_physicalKeyboard && (event->type() == QEvent::KeyPress || event->type() == QEvent::KeyRelease)
+        && event->spontaneous() && isVisible() && watched == QApplication::focusWidget()) {
+        return handlePhysicalKey(static_cast<QWidget *>(watched), static_cast<QKeyEvent *>(event));
     }
 
-    if (!m_targetWidget) {
+    if (watched == m_letterWidget || watched == m_numberWidget || watched == m_symbolKeysWidget) {
+        switch (event->type()) {
+        case QEvent::Resize:
+        case QEvent::LayoutRequest:
+            // 连续的尺寸变化只在最后一次之后重建一次词形索引（符号面板功能键不参与）
+            if (watched != m_symbolKeysWidget) {
+                m_spatialModelDirty = true;
+                m_gestureIndexTimer->start();
+            }
+            break;
+        case QEvent::TouchBegin:
+        case QEvent::TouchUpdate:
+        case QEvent::TouchEnd:
+            handleTouchEvent(static_cast<QWidget *>(watched), static_cast<QTouchEvent *>(event));
+            event->accept();
+            return true;
+        case QEvent::TouchCancel:
+            cancelTouches();
+            event->accept();
+            return true;
+        default:
+            break;
+        }
+    }
+
+    return QWidget::eventFilter(watched, event);
+}
+
+bool Keyboard::handlePhysicalKey(QWidget *receiver, QKeyEvent *event)
+{
+    // 快捷键照常交给目标控件
+    if (event->modifiers() & (Qt::ControlModifier | Qt::AltModifier | Qt::MetaModifier)) {
+        return false;
+    }
+
+    const int key = event->key();
+    const QString text = event->text();
+    const bool printable = text.size() == 1 && text.at(0).isPrint();
+    const bool composing = m_inputMode == Chinese && m_engine->isComposing();
+    if (!printable && key != Qt::Key_Backspace && key != Qt::Key_Return && key != Qt::Key_Enter
+        && !(key == Qt::Key_Escape && composing)) {
+        return false;
+    }
+
+    // 按下时已处理并向目标补发完整的按下/松开，原松开事件一并吞掉
+    if (event->type() == QEvent::KeyRelease) {
+        return true;
+    }
+
+    // 每个按键在事件循环中按到达顺序同步处理，自动重复的按键同样逐个处理
+    m_keyReceiver = receiver;
+    m_keyModifiers = event->modifiers();
+    switch (key) {
+    case Qt::Key_Backspace:
+        onBackspacePressed();
+        break;
+    case Qt::Key_Return:
+    case Qt::Key_Enter:
+        onEnterPressed();
+        break;
+    case Qt::Key_Space:
+        onSpacePressed();
+        break;
+    case Qt::Key_Escape:
+        m_engine->reset();
+        clearCandidates();
+        break;
+    default:
+        if (key >= Qt::Key_1 && key <= Qt::Key_9 && selectCandidate(key - Qt::Key_0)) {
+            break;
+        }
+        onKeyButtonPressed(key, text);
+        break;
+    }
+    m_keyReceiver = nullptr;
+    m_keyModifiers = Qt::NoModifier;
+    return true;
+}
+
+void Keyboard::handleTouchEvent(QWidget *container, QTouchEvent *event)
+{
+    for (const QEventPoint &point : event->points()) {
+        if (point.state() == QEventPoint::Pressed) {
+            // 又有手指按下，尚未开始滑行的触点按普通按键处理
+            if (!m_gestureActive) {
+                m_gestureTouchId = -1;
+            }
+
+            // 按键在按下时确定，之后滑出按键也不改变
+            KeyboardButton *button = buttonAt(container, point.position());
+            if (button) {
+                button->setPressPosition(point.position() - button->pos());
+                button->setTouchDown(true);
+                m_touches.append(TouchKey{point.id(), button, false});
+
+                // 英文模式下单指从字母键开始，移动足够远后按滑行输入处理
+                if (m_inputMode == English && container == m_letterWidget && m_touches.size() == 1
+                    && button->keyCode() >= Qt::Key_A && button->keyCode() <= Qt::Key_Z) {
+                    m_gestureTouchId = point.id();
+                    m_gestureActive = false;
+                    m_gesturePoints = {point.position()};
+                }
+            }
+        } else if (point.id() == m_gestureTouchId && point.state() == QEventPoint::Updated) {
+            trackGesture(point);
+        } else if (point.state() == QEventPoint::Released) {
+            if (point.id() == m_gestureTouchId) {
+                trackGesture(point);
+                if (m_gestureActive) {
+                    finishGesture();
+                    continue;
+                }
+                m_gestureTouchId = -1;
+            }
+
+            for (TouchKey &touch : m_touches) {
+                if (touch.id == point.id() && !touch.released) {
+                    touch.released = true;
+                    touch.button->setTouchDown(false);
+                    break;
+                }
+            }
+        }
+    }
+
+    flushTouches();
+}
+
+void Keyboard::trackGesture(const QEventPoint &point)
+{
+    m_gesturePoints.append(point.position());
+    if (m_gestureActive) {
         return;
     }
 
-    QKeyEvent pressEvent(QEvent::KeyPress, keyCode, Qt::NoModifier, text);
-    QKeyEvent releaseEvent(QEvent::KeyRelease, keyCode, Qt::NoModifier, text);
+    if (m_spatialModelDirty) {
+        updateSpatialModel();
+    }
+    const qreal threshold = 0.7 * m_spatialModel.averageKeyWidth();
+    if (QLineF(m_gesturePoints.first(), point.position()).length() < threshold) {
+        return;
+    }
 
-    QApplication::sendEvent(m_targetWidget, &pressEvent);
-    QApplication::sendEvent(m_targetWidget, &releaseEvent);
+    // 开始滑行：起始键不再显示按下
+    m_gestureActive = true;
+    for (const TouchKey &touch : std::as_const(m_touches)) {
+        if (touch.id == m_gestureTouchId) {
+            touch.button->setTouchDown(false);
+        }
+    }
 }
 
-void Keyboard::sendTextToTarget(const QString &text)
+void Keyboard::finishGesture()
+{
+    // 滑行的触点不作为按键提交
+    for (qsizetype i = 0; i < m_touches.size(); ++i) {
+        if (m_touches.at(i).id == m_gestureTouchId) {
+            m_touches.removeAt(i);
+            break;
+        }
+    }
+
+    // 布局刚变化或词库刚重新加载、索引尚未重建时，抬起时补建一次
+    if (m_gestureDecoderDirty || m_gestureDecoder.isStale()) {
+        m_gestureIndexTimer->stop();
+        rebuildGestureIndex();
+    }
+    const QList<QStringView> words = m_gestureDecoder.decode(m_gesturePoints);
+    m_gestureTouchId = -1;
+    m_gestureActive = false;
+    m_gesturePoints.clear();
+    if (words.isEmpty()) {
+        return;
+    }
+
+    // 上屏最匹配的单词并补一个空格，便于连续滑行
+    const QString word = words.first().toString();
+    commitWord(word, word);
+}
+
+void Keyboard::flushTouches()
+{
+    // 先按下的键先提交：前面的手指未抬起时，后面已抬起的键排队等待
+    while (!m_touches.isEmpty() && m_touches.first().released) {
+        KeyboardButton *button = m_touches.takeFirst().button;
+        button->trigger();
+    }
+}
+
+void Keyboard::cancelTouches()
+{
+    for (const TouchKey &touch : std::as_const(m_touches)) {
+        touch.button->setTouchDown(false);
+    }
+    m_touches.clear();
+
+    m_gestureTouchId = -1;
+    m_gestureActive = false;
+    m_gesturePoints.clear();
+}
+
+KeyboardButton *Keyboard::buttonAt(QWidget *container, const QPointF &pos)
+{
+    KeyboardButton *button = qobject_cast<KeyboardButton *>(container->childAt(pos.toPoint()));
+    if (button || container != m_letterWidget) {
+        return button;
+    }
+
+    // 落在按键间隙时取最近的字母键
+    if (m_spatialModelDirty) {
+        updateSpatialModel();
+    }
+    const QChar letter = m_spatialModel.nearestLetter(pos);
+    return letter.isNull() ? nullptr : m_letterButtons.value(QString(letter));
+}
+
+KeyGuess Keyboard::keyGuess(KeyboardButton *button, QChar key)
+{
+    // 只有字母键使用空间模型，其余情况（数字、物理键盘等）视为确定输入
+    const QChar lower = key.toLower();
+    if (!button || button->parentWidget() != m_letterWidget || lower < u'a' || lower > u'z') {
+        return KeyGuess::exact(key);
+    }
+
+    if (m_spatialModelDirty) {
+        updateSpatialModel();
+    }
+    return m_spatialModel.guess(button->pos() + button->pressPosition());
+}
+
+void Keyboard::updateSpatialModel()
+{
+    m_spatialModel.clear();
+    for (auto it = m_letterButtons.cbegin(); it != m_letterButtons.cend(); ++it) {
+        m_spatialModel.setKeyRect(it.key().at(0), it.value()->geometry());
+    }
+    m_spatialModelDirty = false;
+    m_gestureDecoderDirty = true;
+    if (!m_gestureIndexTimer->isActive()) {
+        m_gestureIndexTimer->start();
+    }
+}
+
+void Keyboard::rebuildGestureIndex()
+{
+    if (m_spatialModelDirty) {
+        updateSpatialModel();
+    }
+    if (m_gestureDecoderDirty || m_gestureDecoder.isStale()) {
+        m_gestureDecoder.setKeyboard(m_spatialModel);
+        m_gestureDecoderDirty = false;
+    }
+}
+
+QWidget *Keyboard::keyTarget() const
 {
-    if (!m_targetWidget) {
-        m_targetWidget = QApplication::focusWidget();
+    // 实体按键发往收到它的控件；否则为指定的目标，未指定时为当前焦点控件（不固定下来）
+    if (m_keyReceiver) {
+        return m_keyReceiver;
     }
+    return m_targetWidget ? m_targetWidget : QApplication::focusWidget();
+}
 
-    if (!m_targetWidget) {
+void Keyboard::sendKeyEventToTarget(int keyCode, const QString &text)
+{
+    QWidget *target = keyTarget();
+    if (!target) {
         return;
     }
 
-    // 逐个字符发送
-    for (const QChar &ch : text) {
-        QString str(ch);
-        QKeyEvent pressEvent(QEvent::KeyPress, 0, Qt::NoModifier, str);
-        QKeyEvent releaseEvent(QEvent::KeyRelease, 0, Qt::NoModifier, str);
+    QKeyEvent pressEvent(QEvent::KeyPress, keyCode, m_keyModifiers, text);
+    QKeyEvent releaseEvent(QEvent::KeyRelease, keyCode, m_keyModifiers, text);
 
-        QApplication::sendEvent(m_targetWidget, &pressEvent);
-        QApplication::sendEvent(m_targetWidget, &releaseEvent);
+    QApplication::sendEvent(target, &pressEvent);
+    QApplication::sendEvent(target, &releaseEvent);
+}
+
+void Keyboard::sendTextToTarget(const QString &text)
+{
+    QWidget *target = keyTarget();
+    if (!target) {
+        return;
     }
+
+    // 整段文本一次发送，避免逐字符构造字符串（也不会拆开代理对）
+    // 上屏的是候选而不是按键本身，不带修饰键
+    QKeyEvent pressEvent(QEvent::KeyPress, 0, Qt::NoModifier, text);
+    QKeyEvent releaseEvent(QEvent::KeyRelease, 0, Qt::NoModifier, text);
+
+    QApplication::sendEvent(target, &pressEvent);
+    QApplication::sendEvent(target, &releaseEvent);
 }
@@ -15,6 +15,12 @@
 #include <QListWidget>
 #include <QMap>
 #include <QKeyEvent>
+#include <QTimer>
+
+#include "inputengine.h"
+#include "gesturedecoder.h"
+#include "englishcompleter.h"
+#include "symbolwidget.h"
 
 // 中文候选词显示控件
 class ChineseWidget : public QListWidget
@@ -23,24 +29,32 @@ class ChineseWidget : public QListWidget
 public:
     explicit ChineseWidget(QWidget *parent = nullptr);
 
-    // 设置拼音，显示候选汉字
-    void setPinyin(const QString &pinyin);
+    // 设置输入编码及其候选词，编码不合法时以红色标出
+    void setComposition(const QString &preedit, const CandidateList &candidates, bool valid = true);
+
+    // 显示联想词（不含拼音条目）
+    void setPredictions(const CandidateList &predictions);
 
     // 清空候选
     void clear();
 
+    // 第 index 个候选（有编码时 0 为编码本身），视图在下次设置/清空前有效
+    QStringView candidateAt(int index) const;
+
 signals:
-    void candidateSelected(const QString &text);
+    void candidateSelected(QStringView text);
 
 private slots:
     void onItemClicked(QListWidgetItem *item);
 
 private:
-    void addCandidate(const QString &text);
-    void loadPinyinDict();  // 加载拼音词典
+    void setCandidateCount(int count);
+    void setCandidateText(int index, const QString &text);
 
 private:
-    QMap<QString, QStringList> m_pinyinDict;  // 拼音->汉字映射
+    QString m_preedit;           // 当前编码（与引擎缓冲共享）
+    CandidateList m_candidates;  // 当前候选词，指向词典存储
+    int m_visibleCount;          // 可见条目数，其余条目隐藏复用
 };
 
 // 键盘按钮
@@ -58,6 +72,14 @@ public:
     // 设置显示文本（用于大小写切换）
     void setDisplayText(const QString &text);
 
+    // 由键盘的触摸处理调用：切换按下状态 / 发出按键
+    void setTouchDown(bool down);
+    void trigger() { emit keyPressed(m_keyCode, text()); }
+
+    // 最近一次按下的位置（按钮坐标），用于空间模型
+    QPointF pressPosition() const { return m_pressPosition; }
+    void setPressPosition(const QPointF &pos) { m_pressPosition = pos; }
+
 signals:
     void keyPressed(int keyCode, const QString &text);
 
@@ -67,6 +89,7 @@ protected:
 
 private:
     int m_keyCode;
+    QPointF m_pressPosition;
     QString m_normalImage;
     QString m_pressedImage;
 
@@ -80,7 +103,8 @@ public:
     enum KeyboardMode {
         LowerCase,    // 小写字母
         UpperCase,    // 大写字母
-        Number        // 数字符号
+        Number,       // 数字
+        Symbol        // 符号与表情
     };
 
     enum InputMode {
@@ -106,30 +130,74 @@ public:
     void setInputMode(InputMode mode);
     InputMode currentInputMode() const { return m_inputMode; }
 
+    // 中文输入引擎（不转移所有权），传入 nullptr 恢复内置拼音引擎
+    void setInputEngine(InputEngine *engine);
+    InputEngine *inputEngine() const { return m_engine; }
+
+    // 实体键盘（含 USB 键盘）：开启后实体按键与屏幕按键走同一处理流程，
+    // 中文输入时数字键 1-9 选择候选、空格上屏首选；键盘隐藏时不拦截
+    void setPhysicalKeyboardEnabled(bool enabled);
+    bool isPhysicalKeyboardEnabled() const { return m_physicalKeyboard; }
+
 signals:
     void keyClicked(int keyCode, const QString &text);
 
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 private slots:
     void onKeyButtonPressed(int keyCode, const QString &text);
     void onCapsLockToggled();
     void onModeChanged();
+    void onSymbolPageToggled();
+    void onSymbolSelected(const QString &symbol);
     void onInputModeChanged();
     void onBackspacePressed();
     void onEnterPressed();
-    void onCandidateSelected(const QString &text);
+    void onSpacePressed();
+    void onCandidateSelected(QStringView text);
+    void showPredictions();
+    void rebuildGestureIndex();
 
 private:
     void setupUI();
     void createLetterKeyboard();
     void createNumberKeyboard();
+    void createSymbolKeyboard();
     void updateKeyboardDisplay();
 
     KeyboardButton* createButton(const QString &text, int keyCode);
     void addButtonToLayout(QGridLayout *layout, const QString &text, int keyCode,
                            int row, int col, int rowSpan = 1, int colSpan = 1);
 
+    // 多点触摸：每个触点独立跟踪按键，按按下顺序提交
+    void handleTouchEvent(QWidget *container, QTouchEvent *event);
+    void flushTouches();
+    void cancelTouches();
+    KeyboardButton *buttonAt(QWidget *container, const QPointF &pos);
+
+    // 滑行输入（英文模式、单指从字母键开始滑动）
+    void trackGesture(const QEventPoint &point);
+    void finishGesture();
+
+    // 布局稳定多久后重建词形索引（毫秒）
+    static constexpr int GestureIndexDelay = 200;
+
+    // 实体键盘按键，返回 true 表示已处理（原事件不再发送给目标控件）
+    bool handlePhysicalKey(QWidget *receiver, QKeyEvent *event);
+    bool selectCandidate(int number);
+
+    // 空间模型：由按键位置估计实际想按的字母
+    KeyGuess keyGuess(KeyboardButton *button, QChar key);
+    void updateSpatialModel();
+
+    QWidget *keyTarget() const;
     void sendKeyEventToTarget(int keyCode, const QString &text);
     void sendTextToTarget(const QString &text);
+    void updateComposition();
+    void updateCompletions();
+    void commitWord(const QString &word, const QString &text);
+    void clearCandidates();
 
 private:
     QWidget *m_targetWidget;
@@ -138,24 +206,60 @@ private:
     // 中文候选词控件
     ChineseWidget *m_chineseWidget;
 
-    // 字母键盘和数字键盘
+    // 字母键盘、数字键盘
     QWidget *m_letterWidget;
     QWidget *m_numberWidget;
     QGridLayout *m_letterLayout;
     QGridLayout *m_numberLayout;
 
+    // 符号面板（符号网格 + 底部功能键）
+    QWidget *m_symbolPage;
+    SymbolWidget *m_symbolWidget;
+    QWidget *m_symbolKeysWidget;
+
     // 模式状态
     KeyboardMode m_keyboardMode;  // 键盘模式（大小写/数字）
     InputMode m_inputMode;        // 输入模式（中英文）
     bool m_capsLock;
+    bool m_physicalKeyboard;      // 是否接管实体键盘输入
 
-    // 中文输入缓冲
-    QString m_pinyinBuffer;
+    // 正在处理的实体按键：处理期间的输出发往收到该按键的控件，并带上原修饰键
+    QWidget *m_keyReceiver;
+    Qt::KeyboardModifiers m_keyModifiers;
+
+    // 中文输入引擎
+    PinyinEngine m_pinyinEngine;
+    InputEngine *m_engine;  // 当前引擎，默认为内置拼音引擎
+    QString m_lastCommit;  // 最近一次上屏的文本，用于联想
+
+    // 英文单词补全
+    EnglishCompleter m_completer;
 
     // 按钮引用（用于更新显示）
     QMap<QString, KeyboardButton*> m_letterButtons;
     KeyboardButton *m_inputModeButton;  // 中英文切换按钮
 
+    // 触摸中的按键，按按下顺序排列
+    struct TouchKey {
+        int id;
+        KeyboardButton *button;
+        bool released;
+    };
+    QList<TouchKey> m_touches;
+
+    // 字母键几何，按键区域尺寸变化后延迟重建
+    KeySpatialModel m_spatialModel;
+    bool m_spatialModelDirty;
+
+    // 滑行输入：跟踪中的触点及其轨迹（字母键区域坐标）
+    // 词形索引在布局稳定后由定时器重建，不在触摸处理中进行
+    GestureDecoder m_gestureDecoder;
+    bool m_gestureDecoderDirty;
+    QTimer *m_gestureIndexTimer;
+    int m_gestureTouchId;   // -1 表示没有跟踪中的触点
+    bool m_gestureActive;   // 移动距离已超过阈值，按滑行处理
+    QList<QPointF> m_gesturePoints;
+
     // 样式配置
     QSize m_buttonSize;
     QString m_buttonStyleSheet;
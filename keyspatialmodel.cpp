@@ -0,0 +1,118 @@
+/**********************************************************
+ * Key Spatial Model Implementation
+ * 按键空间模型实现
+ **********************************************************/
+
+#include "keyspatialmodel.h"
+#include <QtMath>
+
+// 标准差取按键尺寸的 0.4 倍：落在键中心时相邻键约占 4%，落在键边缘时两键各半
+static const float kSigmaScale = 0.4f;
+
+KeySpatialModel::KeySpatialModel()
+{
+    clear();
+}
+
+void KeySpatialModel::clear()
+{
+    for (int i = 0; i < 26; ++i) {
+        m_present[i] = false;
+    }
+    m_keyCount = 0;
+}
+
+void KeySpatialModel::setKeyRect(QChar letter, const QRectF &rect)
+{
+    const int index = letter.toLower().unicode() - u'a';
+    if (index < 0 || index >= 26 || rect.isEmpty()) {
+        return;
+    }
+
+    if (!m_present[index]) {
+        m_present[index] = true;
+        ++m_keyCount;
+    }
+    m_keys[index] = Key{rect.center(),
+                        float(rect.width()),
+                        float(rect.width()) * kSigmaScale,
+                        float(rect.height()) * kSigmaScale};
+}
+
+KeyGuess KeySpatialModel::guess(const QPointF &pos) const
+{
+    KeyGuess result;
+    float total = 0.0f;
+
+    for (int i = 0; i < 26; ++i) {
+        if (!m_present[i]) {
+            continue;
+        }
+
+        const Key &key = m_keys[i];
+        const float dx = float(pos.x() - key.center.x()) / key.sigmaX;
+        const float dy = float(pos.y() - key.center.y()) / key.sigmaY;
+        const float weight = qExp(-0.5f * (dx * dx + dy * dy));
+        total += weight;
+
+        // 插入排序，只保留前 MaxLetters 个
+        int slot = result.count < KeyGuess::MaxLetters ? result.count++ : KeyGuess::MaxLetters;
+        while (slot > 0 && result.probabilities[slot - 1] < weight) {
+            if (slot < KeyGuess::MaxLetters) {
+                result.letters[slot] = result.letters[slot - 1];
+                result.probabilities[slot] = result.probabilities[slot - 1];
+            }
+            --slot;
+        }
+        if (slot < KeyGuess::MaxLetters) {
+            result.letters[slot] = char16_t(u'a' + i);
+            result.probabilities[slot] = weight;
+        }
+    }
+
+    // 离所有键都很远时退化为最近的键
+    if (total <= 0.0f) {
+        const QChar nearest = nearestLetter(pos);
+        return nearest.isNull() ? KeyGuess() : KeyGuess::exact(nearest);
+    }
+
+    for (int i = 0; i < result.count; ++i) {
+        result.probabilities[i] /= total;
+    }
+    return result;
+}
+
+QChar KeySpatialModel::nearestLetter(const QPointF &pos) const
+{
+    QChar nearest;
+    qreal best = 0;
+
+    for (int i = 0; i < 26; ++i) {
+        if (!m_present[i]) {
+            continue;
+        }
+
+        const QPointF delta = pos - m_keys[i].center;
+        const qreal distance = QPointF::dotProduct(delta, delta);
+        if (nearest.isNull() || distance < best) {
+            nearest = QChar(u'a' + i);
+            best = distance;
+        }
+    }
+    return nearest;
+}
+
+qreal KeySpatialModel::averageKeyWidth() const
+{
+    if (m_keyCount == 0) {
+        return 0;
+    }
+
+    qreal total = 0;
+    for (int i = 0; i < 26; ++i) {
+        if (m_present[i]) {
+            total += m_keys[i].width;
+        }
+    }
+    return total / m_keyCount;
+}
@@ -0,0 +1,67 @@
+/**********************************************************
+ * Key Spatial Model - touch position to key probabilities
+ * 按键空间模型（触点位置 -> 各字母键的概率）
+ **********************************************************/
+
+#ifndef KEYSPATIALMODEL_H
+#define KEYSPATIALMODEL_H
+
+#include <QChar>
+#include <QPointF>
+#include <QRectF>
+
+// 一次按键可能对应的字母，按概率从高到低排列，定长无分配
+struct KeyGuess
+{
+    static constexpr int MaxLetters = 4;
+
+    char16_t letters[MaxLetters] = {};
+    float probabilities[MaxLetters] = {};
+    int count = 0;
+
+    // 确定的按键（物理键盘或无位置信息时）
+    static KeyGuess exact(QChar letter)
+    {
+        KeyGuess guess;
+        guess.letters[0] = letter.toLower().unicode();
+        guess.probabilities[0] = 1.0f;
+        guess.count = 1;
+        return guess;
+    }
+};
+
+// 字母键几何信息，按高斯分布估计触点落在各键上的概率
+class KeySpatialModel
+{
+public:
+    KeySpatialModel();
+
+    void clear();
+    void setKeyRect(QChar letter, const QRectF &rect);
+    bool isEmpty() const { return m_keyCount == 0; }
+
+    // 触点对应的候选字母（仅保留概率最高的几个）
+    KeyGuess guess(const QPointF &pos) const;
+
+    // 距触点最近的字母，没有按键时返回空字符
+    QChar nearestLetter(const QPointF &pos) const;
+
+    // 键的几何信息（index 为 0-25 对应 a-z）
+    bool hasKey(int index) const { return m_present[index]; }
+    QPointF keyCenter(int index) const { return m_keys[index].center; }
+    qreal averageKeyWidth() const;
+
+private:
+    struct Key {
+        QPointF center;
+        float width;
+        float sigmaX;
+        float sigmaY;
+    };
+
+    Key m_keys[26];
+    bool m_present[26];
+    int m_keyCount;
+};
+
+#endif // KEYSPATIALMODEL_H
@@ -0,0 +1,171 @@
+/**********************************************************
+ * Pinyin Converter Implementation
+ * 拼音转换实现
+ **********************************************************/
+
+#include "pinyinconverter.h"
+#include "pinyindict.h"
+#include "pinyinsyllables.h"
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+#include <climits>
+
+// 无法转换的字母按原样保留时的代价，远大于任何正常分段
+static const int kPassthroughCost = 1000;
+
+QString PinyinConverter::convert(QStringView pinyin) const
+{
+    QString result;
+    result.reserve(pinyin.size());
+
+    // 按字母连续段分别转换，分隔符本身不输出
+    qsizetype start = 0;
+    for (qsizetype i = 0; i <= pinyin.size(); ++i) {
+        const QChar ch = i < pinyin.size() ? pinyin[i].toLower() : QChar();
+        if (i < pinyin.size() && ch >= u'a' && ch <= u'z') {
+            continue;
+        }
+
+        if (i > start) {
+            convertRun(pinyin.sliced(start, i - start), &result);
+        }
+        if (i < pinyin.size() && ch != u' ' && ch != u'\'') {
+            result += pinyin[i];
+        }
+        start = i + 1;
+    }
+    return result;
+}
+
+void PinyinConverter::convertRun(QStringView run, QString *out) const
+{
+    // 动态规划：cost[i] 为前 i 个字母的最少分段数，由每个起点向后沿音节自动机延伸，
+    // 只有恰好切分为完整音节的片段才查词典
+    const qsizetype length = run.size();
+    QString lower = run.toString().toLower();
+    QList<int> cost(length + 1, INT_MAX);
+    QList<qsizetype> from(length + 1, -1);
+    QList<CandidateList> best(length + 1);
+    cost[0] = 0;
+
+    const PinyinDict &dict = PinyinDict::instance();
+    for (qsizetype start = 0; start < length; ++start) {
+        if (cost.at(start) == INT_MAX) {
+            continue;
+        }
+
+        // 无法转换时保留一个字母，保证总有解
+        if (cost.at(start) + kPassthroughCost < cost.at(start + 1)) {
+            cost[start + 1] = cost.at(start) + kPassthroughCost;
+            from[start + 1] = start;
+            best[start + 1] = CandidateList();
+        }
+
+        PinyinSyllables::PrefixState state;
+        const qsizetype limit = qMin<qsizetype>(length, start + MaxPhraseLength);
+        for (qsizetype end = start + 1; end <= limit; ++end) {
+            state = state.advance(lower.at(end - 1).unicode());
+            if (!state.isValid()) {
+                break;
+            }
+            if (!state.isComplete() || cost.at(start) + 1 >= cost.at(end)) {
+                continue;
+            }
+
+            const CandidateList candidates = dict.lookup(QStringView(lower).sliced(start, end - start));
+            if (!candidates.isEmpty()) {
+                cost[end] = cost.at(start) + 1;
+                from[end] = start;
+                best[end] = candidates;
+            }
+        }
+    }
+
+    // 回溯各段，按从前到后的顺序输出
+    QList<qsizetype> ends;
+    for (qsizetype end = length; end > 0; end = from.at(end)) {
+        ends.append(end);
+    }
+    for (auto it = ends.crbegin(); it != ends.crend(); ++it) {
+        const qsizetype end = *it;
+        if (best.at(end).isEmpty()) {
+            out->append(run.sliced(from.at(end), end - from.at(end)));
+        } else {
+            out->append(best.at(end).at(0));
+        }
+    }
+}
+
+namespace {
+
+// 每次批量转换的序号；线程记录自己最近参与的批次，首次参与某批次时计数一次
+QAtomicInteger<quint64> g_batchSerial;
+thread_local quint64 t_lastBatch = 0;
+
+} // namespace
+
+QList<QString> PinyinConverter::convertBatch(const QList<QString> &inputs, BatchStats *stats) const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const qsizetype count = inputs.size();
+    QList<QString> outputs(count);
+    QString *out = outputs.data();
+
+    // 每个线程分到几个任务以平衡负载，但每个任务不少于 BatchChunkSize 条
+    const int threadCount = qMax(1, QThread::idealThreadCount());
+    const qsizetype chunk = qMax(BatchChunkSize, (count + threadCount * 4 - 1) / (threadCount * 4));
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    QSemaphore done;
+    QAtomicInt threadsUsed;
+    const quint64 batch = g_batchSerial.fetchAndAddRelaxed(1) + 1;
+    int tasks = 0;
+    for (qsizetype first = 0; first < count; first += chunk) {
+        const qsizetype last = qMin(count, first + chunk);
+        auto task = [this, &inputs, out, first, last, batch, &threadsUsed, &done]() {
+            if (t_lastBatch != batch) {
+                t_lastBatch = batch;
+                threadsUsed.ref();
+            }
+            for (qsizetype i = first; i < last; ++i) {
+                out[i] = convert(inputs.at(i));
+            }
+            done.release();
+        };
+
+        // 最后一段由当前线程处理；线程池已满（例如本身在池中线程调用）时也在当前线程执行
+        if (last == count || !pool->tryStart(task)) {
+            task();
+        }
+        ++tasks;
+    }
+    done.acquire(tasks);
+
+    if (stats) {
+        stats->count = count;
+        stats->elapsedUs = timer.nsecsElapsed() / 1000;
+        stats->threads = threadsUsed.loadRelaxed();   // 实际执行过任务的线程数
+    }
+    return outputs;
+}
+
+PinyinConverter::BatchStats PinyinConverter::benchmark(const QList<QString> &inputs, int rounds) const
+{
+    BatchStats total;
+    for (int i = 0; i < rounds; ++i) {
+        BatchStats round;
+        convertBatch(inputs, &round);
+        total.count += round.count;
+        total.elapsedUs += round.elapsedUs;
+        total.threads = qMax(total.threads, round.threads);
+    }
+
+    qInfo("PinyinConverter: %lld strings in %lld us on %d threads (%.0f/s)",
+          qlonglong(total.count), qlonglong(total.elapsedUs), total.threads, total.perSecond());
+    return total;
+}
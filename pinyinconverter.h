@@ -0,0 +1,46 @@
+/**********************************************************
+ * Pinyin Converter - headless pinyin to Chinese conversion
+ * 拼音转换（不依赖界面，可在任意线程批量使用）
+ **********************************************************/
+
+#ifndef PINYINCONVERTER_H
+#define PINYINCONVERTER_H
+
+#include <QString>
+#include <QStringView>
+#include <QList>
+
+// 整段拼音转换为汉字，只依赖 QtCore
+// 转换器本身无状态，词典只读（压缩词典的缓存有锁保护），同一实例可被多个线程同时使用
+class PinyinConverter
+{
+public:
+    // 单个词组的最大拼音长度（超过后不再作为一段查找）
+    static constexpr int MaxPhraseLength = 32;
+
+    // 批量转换时每个任务处理的最少条数
+    static constexpr qsizetype BatchChunkSize = 256;
+
+    // 批量转换的吞吐统计
+    struct BatchStats {
+        qsizetype count = 0;        // 转换条数
+        qint64 elapsedUs = 0;       // 总耗时（微秒）
+        int threads = 0;            // 参与的线程数
+        double perSecond() const { return elapsedUs > 0 ? count * 1e6 / elapsedUs : 0; }
+    };
+
+    // 转换一段拼音：按最少分段切分为词典中存在的词组，每段取首选候选
+    // 空格和隔音符 ' 强制分段，非字母字符及无法转换的字母原样保留
+    QString convert(QStringView pinyin) const;
+
+    // 并行转换，结果与输入一一对应；stats 非空时返回吞吐统计
+    QList<QString> convertBatch(const QList<QString> &inputs, BatchStats *stats = nullptr) const;
+
+    // 基准测试：重复批量转换 rounds 次，返回合计吞吐
+    BatchStats benchmark(const QList<QString> &inputs, int rounds = 3) const;
+
+private:
+    void convertRun(QStringView run, QString *out) const;
+};
+
+#endif // PINYINCONVERTER_H
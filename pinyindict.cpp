@@ -0,0 +1,430 @@
+/**********************************************************
+ * Pinyin Dictionary Implementation
+ * 拼音词典实现
+ **********************************************************/
+
+#include "pinyindict.h"
+#include "compresseddict.h"
+#include <algorithm>
+
+namespace {
+
+// 静态词典表 - 候选词以空格分隔，存放于只读数据段
+struct PinyinSource {
+    const char *pinyin;
+    const char16_t *candidates;
+};
+
+const PinyinSource kPinyinTable[] = {
+    // 简化的拼音词典 - 常用汉字
+    // 格式: 拼音 -> 汉字列表
+    {"a", u"啊 阿 呵 腌"},
+    {"ai", u"爱 哀 挨 碍 癌 矮 艾"},
+    {"an", u"安 按 岸 暗 案 鞍 俺"},
+    {"ang", u"昂 肮 盎"},
+
+    {"ba", u"把 爸 吧 八 巴 拔 跋 霸 罢 坝"},
+    {"bai", u"白 百 摆 败 拜 柏"},
+    {"ban", u"办 半 班 板 版 伴 扮 拌 颁"},
+    {"bang", u"帮 邦 棒 磅 榜 绑 膀 镑"},
+    {"bao", u"报 保 包 薄 抱 暴 爆 饱 宝 堡"},
+    {"bei", u"被 北 备 背 倍 杯 悲 碑 卑"},
+    {"ben", u"本 奔 笨 苯"},
+    {"beng", u"蹦 崩 绷 泵"},
+    {"bi", u"比 笔 必 闭 彼 逼 毕 鼻 碧 壁"},
+    {"bian", u"变 边 便 遍 编 辩 辨 鞭 贬"},
+    {"biao", u"表 标 彪 膘 裱 镖"},
+    {"bie", u"别 憋 瘪"},
+    {"bin", u"宾 滨 彬 濒 摈"},
+    {"bing", u"并 病 兵 冰 饼 屏 炳"},
+    {"bo", u"不 播 波 博 伯 玻 剥 薄 驳 泊"},
+    {"bu", u"不 步 部 布 补 捕 卜 哺"},
+
+    {"ca", u"擦 嚓"},
+    {"cai", u"才 菜 材 财 采 彩 睬 裁"},
+    {"can", u"参 残 惭 灿 餐 蚕"},
+    {"cang", u"藏 仓 苍 沧"},
+    {"cao", u"草 操 曹 槽 糙"},
+    {"ce", u"策 测 侧 厕 册"},
+    {"ceng", u"层 曾 蹭"},
+    {"cha", u"查 茶 差 插 察 叉 刹 岔"},
+    {"chai", u"拆 柴 豺"},
+    {"chan", u"产 单 缠 掺 蝉 馋 颤 铲"},
+    {"chang", u"长 常 场 唱 厂 畅 昌 尝 偿 肠"},
+    {"chao", u"超 朝 潮 吵 炒 抄 钞 巢 嘲"},
+    {"che", u"车 彻 撤 扯"},
+    {"chen", u"沉 陈 晨 臣 尘 衬 趁 称"},
+    {"cheng", u"成 城 程 承 称 诚 乘 盛 呈 撑"},
+    {"chi", u"吃 持 尺 赤 迟 齿 耻 翅 斥 炽"},
+    {"chong", u"重 冲 充 虫 崇 宠 冲"},
+    {"chou", u"抽 愁 臭 仇 筹 绸 稠 丑"},
+    {"chu", u"出 处 初 除 础 储 楚 触 畜 厨"},
+    {"chuan", u"传 川 船 穿 串 喘"},
+    {"chuang", u"创 窗 床 闯 疮"},
+    {"chui", u"吹 垂 锤 炊 捶"},
+    {"chun", u"春 纯 唇 醇 蠢"},
+    {"chuo", u"戳 绰"},
+    {"ci", u"此 次 词 辞 刺 赐 磁 瓷 雌"},
+    {"cong", u"从 聪 葱 丛 匆"},
+    {"cou", u"凑 辏"},
+    {"cu", u"粗 促 醋 簇 蔟"},
+    {"cuan", u"窜 篡 蹿"},
+    {"cui", u"催 脆 翠 摧 璨 悴"},
+    {"cun", u"存 村 寸"},
+    {"cuo", u"错 措 挫 搓 磋 撮"},
+
+    {"da", u"大 打 答 达 搭"},
+    {"dai", u"带 代 待 大 呆 贷 戴 袋"},
+    {"dan", u"但 单 担 弹 蛋 淡 胆 旦 氮"},
+    {"dang", u"当 党 档 挡 荡 宕"},
+    {"dao", u"到 道 导 倒 刀 岛 盗 悼 稻"},
+    {"de", u"的 得 地 德"},
+    {"deng", u"等 灯 登 邓 蹬 瞪 凳"},
+    {"di", u"地 第 底 低 敌 滴 迪 的 弟 帝"},
+    {"dian", u"点 店 电 典 殿 碘 淀 垫 惦"},
+    {"diao", u"掉 调 吊 钓 刁 雕 凋"},
+    {"die", u"跌 爹 碟 蝶 迭 谍 叠"},
+    {"ding", u"定 顶 订 钉 丁 盯 叮 鼎"},
+    {"dong", u"东 动 懂 冬 董 洞 冻 栋"},
+    {"dou", u"都 斗 豆 抖 陡 逗 痘"},
+    {"du", u"读 度 独 都 毒 堵 赌 杜 肚"},
+    {"duan", u"段 短 断 端 锻 缎 煅"},
+    {"dui", u"对 队 堆 兑 敦 碓"},
+    {"dun", u"顿 吨 蹲 盾 敦 钝 墩 囤"},
+    {"duo", u"多 夺 朵 躲 duo 垛 堕 惰"},
+
+    {"e", u"而 儿 额 恶 饿 鹅 蛾 俄 扼"},
+    {"en", u"恩"},
+    {"er", u"而 儿 二 耳 尔 饵 洱"},
+
+    {"fa", u"发 法 罚 乏 伐 筏 阀"},
+    {"fan", u"反 饭 犯 范 返 翻 凡 烦 繁 泛"},
+    {"fang", u"方 放 房 防 仿 访 纺 芳"},
+    {"fei", u"非 飞 费 肥 废 沸 肺 菲 啡"},
+    {"fen", u"分 份 纷 粉 fen 奋 愤 坟 焚"},
+    {"feng", u"风 丰 封 疯 峰 锋 蜂 逢 缝 凤"},
+    {"fo", u"佛"},
+    {"fou", u"否"},
+    {"fu", u"服 福 父 副 复 负 富 妇 府 符"},
+
+    {"ga", u"尴 嘎 噶"},
+    {"gai", u"该 改 盖 概 钙 溉 丐"},
+    {"gan", u"干 感 敢 赶 刚 甘 肝 杆 柑"},
+    {"gang", u"刚 钢 岗 港 杠 纲 缸"},
+    {"gao", u"高 告 搞 稿 膏 糕 镐 睾"},
+    {"ge", u"个 各 哥 歌 格 隔 割 革 葛"},
+    {"gei", u"给"},
+    {"gen", u"根 跟 艮"},
+    {"geng", u"更 耕 颈 梗 埂 耿 哽"},
+    {"gong", u"工 公 共 功 供 宫 恭 贡 躬 弓"},
+    {"gou", u"够 构 狗 购 沟 勾 钩 gouу"},
+    {"gu", u"古 故 顾 固 骨 谷 股 鼓 雇 姑"},
+    {"gua", u"挂 刮 瓜 寡 guà 卦 褂"},
+    {"guai", u"怪 拐 乖"},
+    {"guan", u"关 管 观 官 馆 冠 贯 惯 灌"},
+    {"guang", u"光 广 逛"},
+    {"gui", u"规 贵 跪 鬼 柜 归 桂 硅 轨"},
+    {"gun", u"滚 棍 辊"},
+    {"guo", u"国 过 果 锅 裹 郭"},
+
+    {"ha", u"哈"},
+    {"hai", u"还 海 害 孩 骸 骇"},
+    {"han", u"和 汉 含 寒 喊 汗 韩 旱 焊"},
+    {"hang", u"行 航 杭 巷 夯"},
+    {"hao", u"好 号 浩 毫 豪 耗 郝 嚎"},
+    {"he", u"和 何 合 河 核 喝 贺 荷 赫"},
+    {"hei", u"黑 嘿"},
+    {"hen", u"很 恨 痕 狠"},
+    {"heng", u"横 恒 衡 哼"},
+    {"hong", u"红 洪 宏 虹 鸿 哄 弘 轰"},
+    {"hou", u"后 候 厚 侯 喉 吼"},
+    {"hu", u"和 户 护 互 呼 胡 湖 壶 糊 虎"},
+    {"hua", u"化 花 华 话 画 滑 划 哗"},
+    {"huai", u"怀 坏 淮 槐"},
+    {"huan", u"换 还 环 欢 缓 幻 唤 患 焕"},
+    {"huang", u"黄 皇 荒 慌 煌 晃 幌 恍 谎"},
+    {"hui", u"会 回 汇 惠 灰 辉 挥 毁 慧"},
+    {"hun", u"婚 混 昏 魂 浑 荤"},
+    {"huo", u"或 活 火 获 货 祸 惑 霍"},
+
+    // 添加更多常用字...
+    {"ji", u"及 机 几 己 技 际 记 集 极 级"},
+    {"jia", u"家 加 价 假 甲 嘉 佳 架 驾 稼"},
+    {"jian", u"见 间 建 件 简 检 坚 减 监 健"},
+    {"jiang", u"将 江 讲 降 jiang 奖 蒋 僵 姜 浆"},
+    {"jiao", u"教 叫 交 较 角 脚 觉 校 焦 胶"},
+    {"jie", u"接 解 结 节 界 姐 街 借 介 届"},
+    {"jin", u"进 今 金 近 仅 紧 尽 劲 禁 斤"},
+    {"jing", u"经 精 京 景 警 静 竞 境 镜 惊"},
+    {"jiong", u"窘 炯 迥"},
+    {"jiu", u"就 九 久 旧 究 救 酒 舅 纠 揪"},
+    {"ju", u"具 据 巨 举 局 句 拒 聚 距 俱"},
+    {"juan", u"卷 圈 捐 juan 倦 眷 绢 隽"},
+    {"jue", u"觉 决 绝 掘 诀 抉 倔 爵 嚼"},
+    {"jun", u"军 君 均 菌 俊 郡 峻 竣"},
+
+    {"ka", u"卡 咖 喀"},
+    {"kai", u"开 凯 慨 楷 揩 铠"},
+    {"kan", u"看 刊 堪 勘 坎 砍 侃"},
+    {"kang", u"康 抗 扛 慷 糠 炕"},
+    {"kao", u"考 靠 烤 拷"},
+    {"ke", u"可 课 科 克 刻 客 渴 壳 咳 颗"},
+    {"ken", u"肯 垦 恳 啃"},
+    {"keng", u"坑 铿"},
+    {"kong", u"空 孔 控 恐"},
+    {"kou", u"口 扣 寇 叩 抠"},
+    {"ku", u"苦 库 哭 酷 裤 窟 骷"},
+    {"kua", u"夸 跨 垮 挎 胯"},
+    {"kuai", u"快 块 筷 会 蒯 侩"},
+    {"kuan", u"宽 款"},
+    {"kuang", u"况 矿 框 狂 旷 匡 筐 眶"},
+    {"kui", u"亏 愧 奎 魁 傀 馈 窥 溃"},
+    {"kun", u"困 捆 昆 坤 kun 琨 髡"},
+    {"kuo", u"扩 括 阔 廓"},
+
+    {"la", u"啦 拉 辣 腊 蜡 垃 喇"},
+    {"lai", u"来 莱 赖 睐 濞"},
+    {"lan", u"蓝 览 懒 栏 烂 兰 拦 篮 澜 揽"},
+    {"lang", u"浪 郎 狼 朗 廊 琅 榔"},
+    {"lao", u"老 劳 牢 捞 涝 烙 姥"},
+    {"le", u"了 乐 勒"},
+    {"lei", u"累 类 泪 雷 垒 擂 蕾 镭"},
+    {"leng", u"冷 愣 棱"},
+    {"li", u"里 理 力 利 立 离 历 李 例 礼"},
+    {"lian", u"连 联 练 脸 恋 廉 莲 链 帘 炼"},
+    {"liang", u"两 量 亮 良 辆 粮 凉 梁 粱 晾"},
+    {"liao", u"了 料 疗 辽 聊 廖 撩 寥 嘹"},
+    {"lie", u"列 烈 裂 猎 劣 冽 咧"},
+    {"lin", u"林 临 邻 淋 琳 霖 磷 鳞 麟"},
+    {"ling", u"零 领 令 灵 另 岭 玲 凌 铃 陵"},
+    {"liu", u"流 六 留 刘 柳 溜 榴 瘤"},
+    {"long", u"龙 隆 笼 聋 拢 垄 陇 垅"},
+    {"lou", u"楼 漏 陋 搂 篓 镂"},
+    {"lu", u"路 录 露 鲁 陆 卢 炉 绿 鹿 芦"},
+    {"lv", u"绿 率 律 虑 旅 吕 铝 履 滤 氯"},
+    {"luan", u"乱 卵 孪 峦 滦 挛"},
+    {"lue", u"略 掠 lue"},
+    {"lun", u"论 轮 伦 沦 抡"},
+    {"luo", u"落 罗 洛 络 骆 锣 螺 逻 裸"},
+
+    {"ma", u"吗 妈 马 骂 吗 麻 嘛 蚂 码"},
+    {"mai", u"买 卖 迈 麦 脉 埋"},
+    {"man", u"满 慢 漫 曼 蛮 瞒 馒 蔓"},
+    {"mang", u"忙 芒 盲 茫 莽 蟒"},
+    {"mao", u"没 毛 茂 冒 帽 貌 贸 矛 茅 锚"},
+    {"me", u"么"},
+    {"mei", u"没 每 美 妹 媒 煤 梅 昧 魅 枚"},
+    {"men", u"们 门 闷 们"},
+    {"meng", u"梦 盟 猛 蒙 萌 朦 檬 孟"},
+    {"mi", u"米 密 迷 秘 蜜 谜 觅 泌 眯 靡"},
+    {"mian", u"面 免 棉 眠 绵 勉 缅 腼 渑"},
+    {"miao", u"秒 妙 苗 描 渺 缪 庙 瞄 藐"},
+    {"mie", u"灭 蔑 篾"},
+    {"min", u"民 敏 闽 抿 皿 泯 悯 珉"},
+    {"ming", u"明 名 命 鸣 铭 冥 茗 溟"},
+    {"miu", u"谬"},
+    {"mo", u"模 么 摸 莫 磨 墨 末 漠 默 膜"},
+    {"mou", u"某 谋 牟 眸 哞"},
+    {"mu", u"目 木 母 牧 幕 墓 慕 睦 穆 姆"},
+
+    {"na", u"那 拿 哪 na 纳 钠 娜 捺"},
+    {"nai", u"奶 耐 奈 乃 氖 萘"},
+    {"nan", u"南 难 男 喃 楠 囡"},
+    {"nang", u"囊 馕"},
+    {"nao", u"脑 闹 恼 挠 瑙 淖"},
+    {"ne", u"呢"},
+    {"nei", u"内"},
+    {"nen", u"嫩 恁"},
+    {"neng", u"能"},
+    {"ni", u"你 尼 泥 拟 逆 腻 妮 匿 倪 霓"},
+    {"nian", u"年 念 娘 捻 碾 辗 黏 蔫 拈"},
+    {"niang", u"娘 酿"},
+    {"niao", u"鸟 尿 袅 茑"},
+    {"nie", u"捏 聂 啮 镊 孽 蹑 臬"},
+    {"nin", u"您 宁"},
+    {"ning", u"宁 凝 拧 泞 柠 狞 咛"},
+    {"niu", u"牛 扭 纽 钮 拗"},
+    {"nong", u"农 浓 弄 侬 脓"},
+    {"nu", u"奴 努 怒 弩 驽"},
+    {"nv", u"女 恼"},
+    {"nuan", u"暖"},
+    {"nue", u"虐 疟"},
+    {"nuo", u"诺 懦 糯 挪 傩 喏"},
+
+    // ... 可以继续添加更多拼音
+
+    // 添加常用词组的拼音映射（简化版）
+    {"nihao", u"你好"},
+    {"zhongguo", u"中国"},
+    {"xiexie", u"谢谢"},
+    {"zaijian", u"再见"},
+};
+
+// 联想表 - 上屏文本 -> 常见的后续词（按常用程度排列），整词优先，单字兜底
+struct SuccessorSource {
+    const char16_t *text;
+    const char16_t *successors;
+};
+
+const SuccessorSource kSuccessorTable[] = {
+    // 词组
+    {u"你好", u"吗 啊 呀 我是 请问"},
+    {u"中国", u"人 的 人民 共产党 政府 经济 文化"},
+    {u"谢谢", u"你 您 大家 你们 了"},
+    {u"再见", u"了 啊 吧"},
+    {u"我们", u"的 是 在 都 一起 可以 要"},
+    {u"你们", u"的 好 是 在 都 要"},
+    {u"他们", u"的 是 在 都 说"},
+    {u"今天", u"是 的 天气 晚上 下午 上午"},
+    {u"明天", u"见 是 的 早上 下午 晚上"},
+    {u"昨天", u"的 晚上 下午 我"},
+    {u"现在", u"的 是 在 就 开始"},
+    {u"时候", u"的 了 我 就"},
+    {u"工作", u"的 了 人员 时间 中"},
+    {u"学习", u"的 了 一下 方法"},
+    {u"什么", u"时候 事 意思 样 地方"},
+    {u"怎么", u"了 样 办 说 做 回事"},
+    {u"为什么", u"要 不 会 呢"},
+    {u"没有", u"了 人 什么 问题 时间"},
+    {u"可以", u"的 了 吗 吧 在"},
+    {u"知道", u"了 的 吗 你 我"},
+
+    // 单字
+    {u"我", u"们 的 是 在 要 想 也 不 就 爱"},
+    {u"你", u"好 们 的 是 在 要 也 不 说"},
+    {u"他", u"们 的 是 在 说 也"},
+    {u"她", u"们 的 是 在 说"},
+    {u"的", u"人 时候 话 事 东西"},
+    {u"是", u"的 不是 我 你 一个"},
+    {u"不", u"是 要 会 能 好 知道 了"},
+    {u"在", u"这里 那里 家 一起 哪里"},
+    {u"有", u"的 没有 什么 人 一个 时间"},
+    {u"好", u"的 了 吗 啊 吧 不好"},
+    {u"大", u"家 学 的 概 小"},
+    {u"中", u"国 心 间 文 午"},
+    {u"一", u"个 起 下 些 样 定"},
+    {u"上", u"海 班 面 午 学 网"},
+    {u"下", u"午 班 面 来 去 次"},
+    {u"谢", u"谢 谢你"},
+    {u"再", u"见 说 来 也"},
+    {u"什", u"么"},
+    {u"怎", u"么 么样"},
+    {u"这", u"个 里 样 些 是"},
+    {u"那", u"个 里 样 些 么"},
+};
+
+} // namespace
+
+qsizetype splitCandidates(QStringView all, QList<QStringView> *out)
+{
+    // 按空格切分，只保存视图，不复制字符
+    const qsizetype first = out->size();
+    qsizetype start = 0;
+    for (qsizetype i = 0; i <= all.size(); ++i) {
+        if (i == all.size() || all.at(i) == u' ') {
+            if (i > start) {
+                out->append(all.sliced(start, i - start));
+            }
+            start = i + 1;
+        }
+    }
+    return out->size() - first;
+}
+
+const PinyinDict &PinyinDict::instance()
+{
+    return mutableInstance();
+}
+
+PinyinDict &PinyinDict::mutableInstance()
+{
+    static PinyinDict dict;
+    return dict;
+}
+
+bool PinyinDict::loadCompressed(const QString &path, qsizetype cacheBytes)
+{
+    QScopedPointer<CompressedDict> compressed(new CompressedDict);
+    compressed->setCacheSize(cacheBytes);
+    if (!compressed->open(path)) {
+        return false;
+    }
+
+    mutableInstance().m_compressed.swap(compressed);
+    return true;
+}
+
+bool PinyinDict::loadCompressed(const QString &path)
+{
+    return loadCompressed(path, CompressedDict::DefaultCacheBytes);
+}
+
+PinyinDict::~PinyinDict() = default;
+
+PinyinDict::PinyinDict()
+{
+    const qsizetype tableSize = sizeof(kPinyinTable) / sizeof(kPinyinTable[0]);
+    m_entries.reserve(tableSize);
+
+    for (const PinyinSource &source : kPinyinTable) {
+        Entry entry{QLatin1String(source.pinyin), m_candidates.size(), 0};
+        entry.count = splitCandidates(source.candidates, &m_candidates);
+        m_entries.append(entry);
+    }
+
+    std::sort(m_entries.begin(), m_entries.end(), [](const Entry &a, const Entry &b) {
+        return a.pinyin < b.pinyin;
+    });
+
+    const qsizetype successorSize = sizeof(kSuccessorTable) / sizeof(kSuccessorTable[0]);
+    m_successors.reserve(successorSize);
+
+    for (const SuccessorSource &source : kSuccessorTable) {
+        SuccessorEntry entry{QStringView(source.text), m_candidates.size(), 0};
+        entry.count = splitCandidates(source.successors, &m_candidates);
+        m_successors.append(entry);
+    }
+
+    std::sort(m_successors.begin(), m_successors.end(),
+              [](const SuccessorEntry &a, const SuccessorEntry &b) {
+        return a.text < b.text;
+    });
+}
+
+CandidateList PinyinDict::lookup(QStringView pinyin) const
+{
+    if (m_compressed) {
+        return m_compressed->lookup(pinyin);
+    }
+
+    auto it = std::lower_bound(m_entries.cbegin(), m_entries.cend(), pinyin,
+                               [](const Entry &entry, QStringView key) {
+        return key.compare(entry.pinyin) > 0;
+    });
+
+    if (it == m_entries.cend() || pinyin.compare(it->pinyin) != 0) {
+        return CandidateList();
+    }
+
+    const QStringView *first = m_candidates.constData() + it->first;
+    return CandidateList(first, first + it->count);
+}
+
+CandidateList PinyinDict::successors(QStringView text) const
+{
+    // 先匹配整段上屏文本，再依次退到更短的后缀（最后一个字）
+    for (qsizetype len = text.size(); len > 0; --len) {
+        const QStringView suffix = text.right(len);
+        auto it = std::lower_bound(m_successors.cbegin(), m_successors.cend(), suffix,
+                                   [](const SuccessorEntry &entry, QStringView key) {
+            return entry.text < key;
+        });
+
+        if (it != m_successors.cend() && it->text == suffix) {
+            const QStringView *first = m_candidates.constData() + it->first;
+            return CandidateList(first, first + it->count);
+        }
+    }
+
+    return CandidateList();
+}
@@ -0,0 +1,90 @@
+/**********************************************************
+ * Pinyin Dictionary - immutable candidate storage
+ * 拼音词典（只读存储，候选词以视图形式返回）
+ **********************************************************/
+
+#ifndef PINYINDICT_H
+#define PINYINDICT_H
+
+#include <QString>
+#include <QStringView>
+#include <QLatin1String>
+#include <QList>
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+class CompressedDict;
+
+// 候选词列表句柄 - 直接指向词典内部存储，静态存储时复制开销为两个指针
+// 指向动态存储（如解压的词典块）时同时持有其所有权，保证句柄存在期间视图有效
+class CandidateList
+{
+public:
+    CandidateList() = default;
+    CandidateList(const QStringView *begin, const QStringView *end)
+        : m_begin(begin), m_end(end) {}
+    CandidateList(const QStringView *begin, const QStringView *end, QSharedPointer<const void> owner)
+        : m_begin(begin), m_end(end), m_owner(std::move(owner)) {}
+
+    const QStringView *begin() const { return m_begin; }
+    const QStringView *end() const { return m_end; }
+    qsizetype size() const { return m_end - m_begin; }
+    bool isEmpty() const { return m_begin == m_end; }
+    QStringView at(qsizetype i) const { return m_begin[i]; }
+
+    // 是否持有动态存储（持有时会让其所在的存储保持存活）
+    bool ownsStorage() const { return !m_owner.isNull(); }
+
+private:
+    const QStringView *m_begin = nullptr;
+    const QStringView *m_end = nullptr;
+    QSharedPointer<const void> m_owner;
+};
+
+// 将以空格分隔的静态候选串切分为视图追加到 out，返回追加的个数
+qsizetype splitCandidates(QStringView all, QList<QStringView> *out);
+
+// 拼音词典 - 进程内唯一，构造后不再修改，查找可在多个线程中同时进行
+class PinyinDict
+{
+public:
+    static const PinyinDict &instance();
+
+    // 加载压缩词典（由 CompressedDict::build 生成），之后查找由它代替内置词表
+    // cacheBytes 为解压缓存的上限；应在启动时、开始查找前调用
+    static bool loadCompressed(const QString &path, qsizetype cacheBytes);
+    static bool loadCompressed(const QString &path);
+
+    // 查找拼音对应的候选词；内置词表不分配内存，压缩词典只在未缓存时解压一块
+    CandidateList lookup(QStringView pinyin) const;
+
+    // 联想：上屏文本之后可能出现的词，找不到整段时按最后一个字查找
+    CandidateList successors(QStringView text) const;
+
+private:
+    PinyinDict();
+    ~PinyinDict();
+    Q_DISABLE_COPY(PinyinDict)
+
+    static PinyinDict &mutableInstance();
+
+    struct Entry {
+        QLatin1String pinyin;
+        qsizetype first;   // m_candidates 中的起始下标
+        qsizetype count;
+    };
+
+    struct SuccessorEntry {
+        QStringView text;
+        qsizetype first;
+        qsizetype count;
+    };
+
+    QList<Entry> m_entries;              // 按拼音排序
+    QList<SuccessorEntry> m_successors;  // 联想表，按上屏文本排序
+    QList<QStringView> m_candidates;     // 指向静态字符串表的候选词视图
+
+    QScopedPointer<CompressedDict> m_compressed;  // 可选的压缩词典
+};
+
+#endif // PINYINDICT_H
@@ -0,0 +1,360 @@
+/**********************************************************
+ * Pinyin Syllables - compile-time syllable inventory
+ * 拼音音节表（编译期生成的完美哈希与前缀自动机）
+ **********************************************************/
+
+#ifndef PINYINSYLLABLES_H
+#define PINYINSYLLABLES_H
+
+#include <QtGlobal>
+#include <QStringView>
+
+namespace PinyinSyllables {
+
+// 全部合法音节，按字母序排列（ü 写作 v）
+constexpr const char *kSyllables[] = {
+    "a", "ai", "an", "ang", "ao",
+    "ba", "bai", "ban", "bang", "bao", "bei", "ben", "beng", "bi", "bian", "biao",
+    "bie", "bin", "bing", "bo", "bu",
+    "ca", "cai", "can", "cang", "cao", "ce", "cen", "ceng", "cha", "chai", "chan",
+    "chang", "chao", "che", "chen", "cheng", "chi", "chong", "chou", "chu", "chua",
+    "chuai", "chuan", "chuang", "chui", "chun", "chuo", "ci", "cong", "cou", "cu",
+    "cuan", "cui", "cun", "cuo",
+    "da", "dai", "dan", "dang", "dao", "de", "dei", "den", "deng", "di", "dia",
+    "dian", "diao", "die", "ding", "diu", "dong", "dou", "du", "duan", "dui", "dun",
+    "duo",
+    "e", "ei", "en", "eng", "er",
+    "fa", "fan", "fang", "fei", "fen", "feng", "fo", "fou", "fu",
+    "ga", "gai", "gan", "gang", "gao", "ge", "gei", "gen", "geng", "gong", "gou",
+    "gu", "gua", "guai", "guan", "guang", "gui", "gun", "guo",
+    "ha", "hai", "han", "hang", "hao", "he", "hei", "hen", "heng", "hong", "hou",
+    "hu", "hua", "huai", "huan", "huang", "hui", "hun", "huo",
+    "ji", "jia", "jian", "jiang", "jiao", "jie", "jin", "jing", "jiong", "jiu",
+    "ju", "juan", "jue", "jun",
+    "ka", "kai", "kan", "kang", "kao", "ke", "kei", "ken", "keng", "kong", "kou",
+    "ku", "kua", "kuai", "kuan", "kuang", "kui", "kun", "kuo",
+    "la", "lai", "lan", "lang", "lao", "le", "lei", "leng", "li", "lia", "lian",
+    "liang", "liao", "lie", "lin", "ling", "liu", "lo", "long", "lou", "lu", "luan",
+    "lue", "lun", "luo", "lv", "lve",
+    "ma", "mai", "man", "mang", "mao", "me", "mei", "men", "meng", "mi", "mian",
+    "miao", "mie", "min", "ming", "miu", "mo", "mou", "mu",
+    "na", "nai", "nan", "nang", "nao", "ne", "nei", "nen", "neng", "ni", "nian",
+    "niang", "niao", "nie", "nin", "ning", "niu", "nong", "nou", "nu", "nuan",
+    "nue", "nun", "nuo", "nv", "nve",
+    "o", "ou",
+    "pa", "pai", "pan", "pang", "pao", "pei", "pen", "peng", "pi", "pian", "piao",
+    "pie", "pin", "ping", "po", "pou", "pu",
+    "qi", "qia", "qian", "qiang", "qiao", "qie", "qin", "qing", "qiong", "qiu",
+    "qu", "quan", "que", "qun",
+    "ran", "rang", "rao", "re", "ren", "reng", "ri", "rong", "rou", "ru", "rua",
+    "ruan", "rui", "run", "ruo",
+    "sa", "sai", "san", "sang", "sao", "se", "sen", "seng", "sha", "shai", "shan",
+    "shang", "shao", "she", "shei", "shen", "sheng", "shi", "shou", "shu", "shua",
+    "shuai", "shuan", "shuang", "shui", "shun", "shuo", "si", "song", "sou", "su",
+    "suan", "sui", "sun", "suo",
+    "ta", "tai", "tan", "tang", "tao", "te", "tei", "teng", "ti", "tian", "tiao",
+    "tie", "ting", "tong", "tou", "tu", "tuan", "tui", "tun", "tuo",
+    "wa", "wai", "wan", "wang", "wei", "wen", "weng", "wo", "wu",
+    "xi", "xia", "xian", "xiang", "xiao", "xie", "xin", "xing", "xiong", "xiu",
+    "xu", "xuan", "xue", "xun",
+    "ya", "yan", "yang", "yao", "ye", "yi", "yin", "ying", "yo", "yong", "you",
+    "yu", "yuan", "yue", "yun",
+    "za", "zai", "zan", "zang", "zao", "ze", "zei", "zen", "zeng", "zha", "zhai",
+    "zhan", "zhang", "zhao", "zhe", "zhei", "zhen", "zheng", "zhi", "zhong", "zhou",
+    "zhu", "zhua", "zhuai", "zhuan", "zhuang", "zhui", "zhun", "zhuo", "zi", "zong",
+    "zou", "zu", "zuan", "zui", "zun", "zuo",
+};
+
+constexpr int Count = int(sizeof(kSyllables) / sizeof(kSyllables[0]));
+constexpr int MaxLength = 6;
+
+constexpr int length(const char *s)
+{
+    int n = 0;
+    while (s[n]) {
+        ++n;
+    }
+    return n;
+}
+
+constexpr int commonPrefix(const char *a, const char *b)
+{
+    int n = 0;
+    while (a[n] && a[n] == b[n]) {
+        ++n;
+    }
+    return n;
+}
+
+constexpr bool isSorted()
+{
+    for (int i = 1; i < Count; ++i) {
+        const int p = commonPrefix(kSyllables[i - 1], kSyllables[i]);
+        if (kSyllables[i][p] == 0 || (kSyllables[i - 1][p] != 0 && kSyllables[i - 1][p] > kSyllables[i][p])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(isSorted(), "kSyllables must be sorted and unique");
+
+// 每个字母 5 位打包（a=1 ... z=26），最长 6 个字母共 30 位
+constexpr quint32 pack(const char *s)
+{
+    quint32 key = 0;
+    for (int i = 0; s[i]; ++i) {
+        key = (key << 5) | quint32(s[i] - 'a' + 1);
+    }
+    return key;
+}
+
+constexpr quint32 mix(quint32 key, quint32 seed)
+{
+    quint32 h = key * 0x9E3779B1u ^ (seed + 1) * 0x85EBCA6Bu;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    return h;
+}
+
+// ==================== 完美哈希 ====================
+
+struct PerfectHash
+{
+    static constexpr int SlotCount = 512;     // 装载因子约 0.8
+    static constexpr int BucketCount = 256;
+
+    quint32 keys[SlotCount] = {};     // 0 表示空槽
+    qint16 syllables[SlotCount] = {}; // 槽对应的音节下标
+    quint16 seeds[BucketCount] = {};
+};
+
+// 哈希-位移法：先按桶大小从大到小放置，每个桶寻找一个使其成员全部落入空槽的种子
+constexpr PerfectHash buildPerfectHash()
+{
+    PerfectHash hash;
+
+    int bucketStart[PerfectHash::BucketCount + 1] = {};
+    int members[Count] = {};
+    int maxSize = 0;
+
+    for (int i = 0; i < Count; ++i) {
+        ++bucketStart[mix(pack(kSyllables[i]), 0) % PerfectHash::BucketCount + 1];
+    }
+    for (int b = 0; b < PerfectHash::BucketCount; ++b) {
+        maxSize = bucketStart[b + 1] > maxSize ? bucketStart[b + 1] : maxSize;
+        bucketStart[b + 1] += bucketStart[b];
+    }
+
+    int fill[PerfectHash::BucketCount] = {};
+    for (int i = 0; i < Count; ++i) {
+        const int b = int(mix(pack(kSyllables[i]), 0) % PerfectHash::BucketCount);
+        members[bucketStart[b] + fill[b]++] = i;
+    }
+
+    for (int size = maxSize; size > 0; --size) {
+        for (int b = 0; b < PerfectHash::BucketCount; ++b) {
+            if (bucketStart[b + 1] - bucketStart[b] != size) {
+                continue;
+            }
+
+            for (quint32 seed = 1; ; ++seed) {
+                int placed[MaxLength * 4] = {};
+                bool ok = true;
+                for (int m = 0; m < size && ok; ++m) {
+                    const int slot = int(mix(pack(kSyllables[members[bucketStart[b] + m]]), seed)
+                                         % PerfectHash::SlotCount);
+                    ok = hash.keys[slot] == 0;
+                    for (int k = 0; k < m && ok; ++k) {
+                        ok = placed[k] != slot;
+                    }
+                    placed[m] = slot;
+                }
+
+                if (ok) {
+                    for (int m = 0; m < size; ++m) {
+                        const int syllable = members[bucketStart[b] + m];
+                        hash.keys[placed[m]] = pack(kSyllables[syllable]);
+                        hash.syllables[placed[m]] = qint16(syllable);
+                    }
+                    hash.seeds[b] = quint16(seed);
+                    break;
+                }
+            }
+        }
+    }
+
+    return hash;
+}
+
+constexpr PerfectHash kHash = buildPerfectHash();
+
+// 查找音节下标，不合法返回 -1
+template <typename Char>
+constexpr int indexOf(const Char *s, int len)
+{
+    if (len <= 0 || len > MaxLength) {
+        return -1;
+    }
+
+    quint32 key = 0;
+    for (int i = 0; i < len; ++i) {
+        if (s[i] < Char('a') || s[i] > Char('z')) {
+            return -1;
+        }
+        key = (key << 5) | quint32(s[i] - Char('a') + 1);
+    }
+
+    const quint32 seed = kHash.seeds[mix(key, 0) % PerfectHash::BucketCount];
+    const int slot = int(mix(key, seed) % PerfectHash::SlotCount);
+    return kHash.keys[slot] == key ? kHash.syllables[slot] : -1;
+}
+
+constexpr int indexOf(const char *s) { return indexOf(s, length(s)); }
+
+inline int indexOf(QStringView s)
+{
+    return indexOf(s.utf16(), int(s.size()));
+}
+
+inline bool isValid(QStringView s) { return indexOf(s) >= 0; }
+
+constexpr bool checkPerfectHash()
+{
+    for (int i = 0; i < Count; ++i) {
+        if (indexOf(kSyllables[i]) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(checkPerfectHash(), "perfect hash must map every syllable to itself");
+static_assert(indexOf("zhuang") >= 0 && indexOf("zhuangg") < 0 && indexOf("bv") < 0,
+              "syllable lookup sanity check");
+
+// ==================== 前缀自动机 ====================
+
+// 字典树节点数 = 1 + 各音节相对前一个音节新增的前缀数（依赖排序）
+constexpr int countNodes()
+{
+    int nodes = 1 + length(kSyllables[0]);
+    for (int i = 1; i < Count; ++i) {
+        nodes += length(kSyllables[i]) - commonPrefix(kSyllables[i - 1], kSyllables[i]);
+    }
+    return nodes;
+}
+
+struct Automaton
+{
+    static constexpr int NodeCount = countNodes();
+
+    qint16 next[NodeCount][26] = {};  // 0 表示无转移（根节点不会成为转移目标）
+    qint16 syllable[NodeCount] = {};  // 以该节点结尾的音节下标，-1 表示非完整音节
+};
+
+constexpr Automaton buildAutomaton()
+{
+    Automaton automaton;
+    for (int n = 0; n < Automaton::NodeCount; ++n) {
+        automaton.syllable[n] = -1;
+    }
+
+    int nodes = 1;
+    for (int i = 0; i < Count; ++i) {
+        int node = 0;
+        for (const char *c = kSyllables[i]; *c; ++c) {
+            const int letter = *c - 'a';
+            if (automaton.next[node][letter] == 0) {
+                automaton.next[node][letter] = qint16(nodes++);
+            }
+            node = automaton.next[node][letter];
+        }
+        automaton.syllable[node] = qint16(i);
+    }
+    return automaton;
+}
+
+constexpr Automaton kAutomaton = buildAutomaton();
+
+// 输入前缀的状态：可能所处的字典树节点集合
+// 不同节点对应不同长度的末尾音节片段，因此最多 MaxLength 个
+struct PrefixState
+{
+    qint16 nodes[MaxLength] = {0};
+    int count = 1;   // 初始为根节点（空输入合法）
+
+    // 仍可能组成合法拼音
+    constexpr bool isValid() const { return count > 0; }
+
+    // 恰好切分为完整音节
+    constexpr bool isComplete() const
+    {
+        for (int i = 0; i < count; ++i) {
+            if (kAutomaton.syllable[nodes[i]] >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 输入一个字母后的状态：沿当前音节延伸，或在完整音节后开始新音节
+    constexpr PrefixState advance(char16_t ch) const
+    {
+        PrefixState result;
+        result.count = 0;
+        if (ch < u'a' || ch > u'z') {
+            return result;
+        }
+
+        const int letter = ch - u'a';
+        for (int i = 0; i < count; ++i) {
+            const int node = nodes[i];
+            result.add(kAutomaton.next[node][letter]);
+            if (kAutomaton.syllable[node] >= 0) {
+                result.add(kAutomaton.next[0][letter]);
+            }
+        }
+        return result;
+    }
+
+private:
+    constexpr void add(qint16 node)
+    {
+        if (node == 0) {
+            return;
+        }
+        for (int i = 0; i < count; ++i) {
+            if (nodes[i] == node) {
+                return;
+            }
+        }
+        nodes[count++] = node;
+    }
+};
+
+template <typename Char>
+constexpr PrefixState scan(const Char *s, int len)
+{
+    PrefixState state;
+    for (int i = 0; i < len && state.isValid(); ++i) {
+        state = state.advance(char16_t(s[i]));
+    }
+    return state;
+}
+
+constexpr PrefixState scan(const char *s) { return scan(s, length(s)); }
+
+inline PrefixState scan(QStringView s)
+{
+    return scan(s.utf16(), int(s.size()));
+}
+
+static_assert(scan("zhongguo").isComplete() && scan("nih").isValid() && !scan("nih").isComplete()
+              && !scan("nvv").isValid() && !scan("iv").isValid(),
+              "prefix automaton sanity check");
+
+} // namespace PinyinSyllables
+
+#endif // PINYINSYLLABLES_H
@@ -0,0 +1,256 @@
+/**********************************************************
+ * Symbol Page Implementation
+ * 符号与表情面板实现
+ **********************************************************/
+
+#include "symbolwidget.h"
+#include <QScroller>
+#include <QVBoxLayout>
+#include <iterator>
+
+namespace {
+
+using Range = SymbolModel::Range;
+
+// 各分类的码位区间（只选用已分配且可单独显示的区段）
+const Range kPunctuationRanges[] = {
+    {0x0021, 0x002F}, {0x003A, 0x0040}, {0x005B, 0x0060}, {0x007B, 0x007E},
+    {0x00A1, 0x00AC}, {0x00AE, 0x00BF},   // 跳过软连字符
+    {0x2010, 0x2027}, {0x2030, 0x205E},
+};
+
+const Range kCjkRanges[] = {
+    {0x3001, 0x3029},   // 中日韩符号和标点（跳过 U+302A–302F 声调组合符）
+    {0x3030, 0x303F},
+    {0xFF01, 0xFF5E},   // 全角 ASCII
+    {0xFFE0, 0xFFE6},   // 全角货币等
+    {0xFE10, 0xFE19},   // 竖排标点
+    {0xFE30, 0xFE4F},   // 兼容形式
+};
+
+const Range kMathRanges[] = {
+    {0x2150, 0x2189},   // 数字形式（分数、罗马数字）
+    {0x2200, 0x22FF},   // 数学运算符
+    {0x2460, 0x24FF},   // 带圈字母数字
+};
+
+const Range kSymbolRanges[] = {
+    {0x2190, 0x21FF},   // 箭头
+    {0x25A0, 0x25FF},   // 几何图形
+    {0x2600, 0x26FF},   // 杂项符号
+    {0x2700, 0x27BF},   // 装饰符号
+};
+
+const Range kEmojiRanges[] = {
+    {0x1F600, 0x1F64F},   // 表情
+    {0x1F900, 0x1F9FF},   // 补充符号与象形文字
+    {0x1F300, 0x1F3FA},   // 杂项符号与象形文字（跳过 U+1F3FB–1F3FF 肤色修饰符）
+    {0x1F400, 0x1F5FF},
+    {0x1F680, 0x1F6D7},   // 交通与地图
+};
+
+struct SymbolCategory {
+    const char *name;
+    const Range *ranges;
+    int rangeCount;
+};
+
+// 第 0 个标签为常用符号，其余标签依次对应下表
+const SymbolCategory kSymbolCategories[] = {
+    {"标点", kPunctuationRanges, int(std::size(kPunctuationRanges))},
+    {"中文", kCjkRanges, int(std::size(kCjkRanges))},
+    {"数学", kMathRanges, int(std::size(kMathRanges))},
+    {"符号", kSymbolRanges, int(std::size(kSymbolRanges))},
+    {"表情", kEmojiRanges, int(std::size(kEmojiRanges))},
+};
+
+// 尚无使用记录时的常用符号
+const char *const kDefaultRecent[] = {
+    "，", "。", "？", "！", "、", "：", "；", "“", "”", "（", "）", "《", "》", "…", "—",
+    "!", "?", "@", "#", "%", "&", "~", "😀", "👍",
+};
+
+} // namespace
+
+// ==================== SymbolModel 实现 ====================
+
+SymbolModel::SymbolModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_ranges(nullptr)
+{
+    m_starts.append(0);
+}
+
+void SymbolModel::setRanges(const Range *ranges, int count)
+{
+    beginResetModel();
+    m_symbols.clear();
+    m_ranges = ranges;
+    m_starts.resize(1);
+    for (int i = 0; i < count; ++i) {
+        m_starts.append(m_starts.last() + int(ranges[i].last - ranges[i].first) + 1);
+    }
+    endResetModel();
+}
+
+void SymbolModel::setSymbols(const QStringList &symbols)
+{
+    beginResetModel();
+    m_symbols = symbols;
+    m_ranges = nullptr;
+    m_starts.resize(1);
+    endResetModel();
+}
+
+QString SymbolModel::symbolAt(int row) const
+{
+    if (!m_symbols.isEmpty()) {
+        return m_symbols.value(row);
+    }
+    if (row < 0 || row >= m_starts.last()) {
+        return QString();
+    }
+
+    // 区间数很少，顺序定位所在区间
+    int range = 0;
+    while (m_starts.at(range + 1) <= row) {
+        ++range;
+    }
+    const char32_t codePoint = m_ranges[range].first + char32_t(row - m_starts.at(range));
+    return QString::fromUcs4(&codePoint, 1);
+}
+
+int SymbolModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_symbols.isEmpty() ? m_starts.last() : int(m_symbols.size());
+}
+
+QVariant SymbolModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid()) {
+        return QVariant();
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return symbolAt(index.row());
+    case Qt::TextAlignmentRole:
+        return QVariant::fromValue(Qt::Alignment(Qt::AlignCenter));
+    default:
+        return QVariant();
+    }
+}
+
+// ==================== SymbolWidget 实现 ====================
+
+SymbolWidget::SymbolWidget(QWidget *parent)
+    : QWidget(parent)
+    , m_model(new SymbolModel(this))
+{
+    for (const char *symbol : kDefaultRecent) {
+        m_recent.append(QString::fromUtf8(symbol));
+    }
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setSpacing(0);
+    layout->setContentsMargins(0, 0, 0, 0);
+
+    // 焦点留在目标输入控件上
+    m_tabBar = new QTabBar(this);
+    m_tabBar->setFocusPolicy(Qt::NoFocus);
+    m_tabBar->setExpanding(true);
+    m_tabBar->addTab(QStringLiteral("常用"));
+    for (const SymbolCategory &category : kSymbolCategories) {
+        m_tabBar->addTab(QString::fromUtf8(category.name));
+    }
+    layout->addWidget(m_tabBar);
+
+    // 统一格子尺寸 + 分批布局：视图不逐项询问尺寸，只为可见格子取数据
+    m_view = new QListView(this);
+    m_view->setFocusPolicy(Qt::NoFocus);
+    m_view->setViewMode(QListView::ListMode);
+    m_view->setFlow(QListView::LeftToRight);
+    m_view->setWrapping(true);
+    m_view->setResizeMode(QListView::Adjust);
+    m_view->setUniformItemSizes(true);
+    m_view->setGridSize(QSize(CellSize, CellSize));
+    m_view->setLayoutMode(QListView::Batched);
+    m_view->setBatchSize(BatchSize);
+    m_view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_view->setSelectionMode(QAbstractItemView::NoSelection);
+    m_view->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    m_view->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    m_view->setModel(m_model);
+    m_view->setStyleSheet(
+        "QListView {"
+        "   outline: none;"
+        "   border: 1px solid #ddd;"
+        "   background-color: white;"
+        "   color: black;"
+        "   font-size: 20px;"
+        "}"
+        "QListView::item:hover {"
+        "   background: #4395ff;"
+        "   color: white;"
+        "}"
+        );
+    QScroller::grabGesture(m_view->viewport(), QScroller::TouchGesture);
+    layout->addWidget(m_view);
+
+    connect(m_tabBar, &QTabBar::currentChanged, this, &SymbolWidget::onCategoryChanged);
+    connect(m_view, &QListView::clicked, this, &SymbolWidget::onCellClicked);
+
+    onCategoryChanged(m_tabBar->currentIndex());
+}
+
+void SymbolWidget::setRecentSymbols(const QStringList &symbols)
+{
+    m_recent = symbols.mid(0, RecentCount);
+    if (m_tabBar->currentIndex() == 0) {
+        m_model->setSymbols(m_recent);
+    }
+}
+
+void SymbolWidget::showEvent(QShowEvent *event)
+{
+    // 重新打开面板时刷新常用符号的顺序
+    if (m_tabBar->currentIndex() == 0) {
+        m_model->setSymbols(m_recent);
+    }
+    QWidget::showEvent(event);
+}
+
+void SymbolWidget::onCategoryChanged(int index)
+{
+    if (index <= 0) {
+        m_model->setSymbols(m_recent);
+    } else {
+        const SymbolCategory &category = kSymbolCategories[index - 1];
+        m_model->setRanges(category.ranges, category.rangeCount);
+    }
+    m_view->scrollToTop();
+}
+
+void SymbolWidget::onCellClicked(const QModelIndex &index)
+{
+    const QString symbol = m_model->symbolAt(index.row());
+    if (symbol.isEmpty()) {
+        return;
+    }
+
+    addRecent(symbol);
+    emit symbolSelected(symbol);
+}
+
+void SymbolWidget::addRecent(const QString &symbol)
+{
+    // 正在浏览常用符号时不刷新列表，避免格子在手指下移动；切换标签时再更新
+    m_recent.removeOne(symbol);
+    m_recent.prepend(symbol);
+    if (m_recent.size() > RecentCount) {
+        m_recent.removeLast();
+    }
+}
@@ -0,0 +1,82 @@
+/**********************************************************
+ * Symbol Page - virtualized punctuation / symbol / emoji grid
+ * 符号与表情面板（按分类浏览，只绘制可见条目）
+ **********************************************************/
+
+#ifndef SYMBOLWIDGET_H
+#define SYMBOLWIDGET_H
+
+#include <QAbstractListModel>
+#include <QList>
+#include <QListView>
+#include <QStringList>
+#include <QTabBar>
+#include <QWidget>
+
+// 符号模型：条目由码位区间描述，不预先生成文本，
+// 视图请求某一格时才由码位生成字符串，分类大小与内存占用无关
+class SymbolModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    // 码位闭区间
+    struct Range {
+        char32_t first;
+        char32_t last;
+    };
+
+    explicit SymbolModel(QObject *parent = nullptr);
+
+    // 切换到一组码位区间（区间表为静态数据，不复制）
+    void setRanges(const Range *ranges, int count);
+
+    // 切换到显式列表（常用符号）
+    void setSymbols(const QStringList &symbols);
+
+    QString symbolAt(int row) const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+private:
+    const Range *m_ranges;
+    QList<int> m_starts;     // 每个区间第一个条目的行号，末尾为总数
+    QStringList m_symbols;   // 显式列表，非空时优先使用
+};
+
+// 符号面板：分类标签 + 虚拟化网格
+// 网格只为可见的格子取数据并绘制，布局分批进行，打开面板的开销与分类大小无关
+class SymbolWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit SymbolWidget(QWidget *parent = nullptr);
+
+    // 最近使用的符号，最新的在前
+    QStringList recentSymbols() const { return m_recent; }
+    void setRecentSymbols(const QStringList &symbols);
+
+    static constexpr int RecentCount = 32;   // 最多保留的常用符号数
+    static constexpr int CellSize = 44;      // 格子边长（像素）
+    static constexpr int BatchSize = 256;    // 每批布局的条目数
+
+signals:
+    void symbolSelected(const QString &symbol);
+
+protected:
+    void showEvent(QShowEvent *event) override;
+
+private slots:
+    void onCategoryChanged(int index);
+    void onCellClicked(const QModelIndex &index);
+
+private:
+    void addRecent(const QString &symbol);
+
+    QTabBar *m_tabBar;
+    QListView *m_view;
+    SymbolModel *m_model;
+    QStringList m_recent;
+};
+
+#endif // SYMBOLWIDGET_H